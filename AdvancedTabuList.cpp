@@ -30,7 +30,8 @@
 
 using namespace std;
 
-AdvancedTabuList::AdvancedTabuList(const uint32_t& maxIter) : maxIterSinceBest(maxIter) {
+AdvancedTabuList::AdvancedTabuList(const SolverConfig& config) : maxIterSinceBest(config.maximalNumberOfIterationsSinceBest),
+	swapLife(config.advancedTabuSwapLife), shiftLife(config.advancedTabuShiftLife), randomizeEraseAmount(config.advancedTabuRandomizeEraseAmount) {
 	baseInit();
 }
 
@@ -46,10 +47,10 @@ void AdvancedTabuList::addTurnToTabuList(const uint32_t& i, const uint32_t& j, c
 	uint32_t lifeFactor;
 	switch (type)	{
 		case SWAP:
-			lifeFactor = ConfigureRCPSP::ADVANCED_TABU_SWAP_LIFE;
+			lifeFactor = swapLife;
 			break;
 		case SHIFT:
-			lifeFactor = ConfigureRCPSP::ADVANCED_TABU_SHIFT_LIFE;
+			lifeFactor = shiftLife;
 			break;
 		default:
 			throw runtime_error("TabuList::addTurnToTabuList: Unsupported move type!");	
@@ -83,12 +84,12 @@ void AdvancedTabuList::bestSolutionFound()	{
 	return;
 }
 
-uint32_t AdvancedTabuList::goToNextIter()	{
+uint32_t AdvancedTabuList::goToNextIter(uint32_t& randomState)	{
 
 	if (iterSinceBest > maxIterSinceBest)	{
 		// Current location in space is not suitable for improving current solution.
 		// Change location in space by randomizing tabu list.
-		prune();
+		prune(randomState);
 	}
 
 	uint32_t erasedItems = 0;
@@ -119,7 +120,7 @@ uint32_t AdvancedTabuList::goToNextIter()	{
 	return erasedItems;
 }
 
-void AdvancedTabuList::prune()	{
+void AdvancedTabuList::prune(uint32_t& randomState)	{
 	if (!secondBestTabu.empty())	{
 		tabu = secondBestTabu;
 		tabuHash = secondBestTabuHash;
@@ -128,14 +129,15 @@ void AdvancedTabuList::prune()	{
 		tabuHash = bestTabuHash;
 	}
 
-	size_t erasedElements = tabu.size()*ConfigureRCPSP::ADVANCED_TABU_RANDOMIZE_ERASE_AMOUNT;
+	size_t erasedElements = tabu.size()*randomizeEraseAmount;
 
 	vector<size_t> eraseIdxs;
 	for (size_t i = 0; i < tabu.size(); ++i)	{
 		eraseIdxs.push_back(i);
 	}
 
-	random_shuffle(eraseIdxs.begin(), eraseIdxs.end());
+	ShuffleGenerator generator(randomState);
+	random_shuffle(eraseIdxs.begin(), eraseIdxs.end(), generator);
 	eraseIdxs.resize(erasedElements);
 	sort(eraseIdxs.begin(),eraseIdxs.end());
 
@@ -101,10 +101,11 @@ typedef std::unordered_set<BaseElement,BaseElementHash,BaseElementEqual> TabuHas
 class AdvancedTabuList : public TabuList {
 	public:
 		/*!
-		 * \param maxIter Maximal number iterations since last best solution than randomisation of tabu list will be called.
+		 * \param config The configuration of the solver. The maximal number of iterations since the last best solution (then the tabu list
+		 * is randomised), the life expectancies of the moves and the relative amount of erased elements are used.
 		 * \brief Construct empty tabu list and tabu hash. Initialise base variables.
 		 */
-		AdvancedTabuList(const uint32_t& maxIter);
+		AdvancedTabuList(const SolverConfig& config);
 
 		/*!
 		 * \param i Index, activity ID, or something else.
@@ -124,9 +125,9 @@ class AdvancedTabuList : public TabuList {
 		//! Advanced tabu list is informed about new best solution. Randomisation purposes.
 		virtual void bestSolutionFound();
 		//! Inform tabu list about new iteration. Required for update lives of the tabu list elements and for randomisation.
-		virtual uint32_t goToNextIter();
-		//! Randomly erase some amount of the tabu list elements.
-		virtual void prune();
+		virtual uint32_t goToNextIter(uint32_t& randomState);
+		//! Randomly erase some amount of the tabu list elements, the random numbers are drawn from the given state.
+		virtual void prune(uint32_t& randomState);
 
 		//! All allocated resources are automatically freed.
 		virtual ~AdvancedTabuList() { }
@@ -144,6 +145,12 @@ class AdvancedTabuList : public TabuList {
 		uint32_t iterSinceBest;
 		//! Maximal number of iteration (without best solution found) until randomizeTabuList method will be called. (computed at constructor)
 		const uint32_t maxIterSinceBest;	
+		//! Life expectancy of the swap move.
+		const uint32_t swapLife;
+		//! Life expectancy of the shift move.
+		const uint32_t shiftLife;
+		//! Relative amount of erased elements when the tabu list is pruned.
+		const double randomizeEraseAmount;
 		//! Relative amount of erased element per one iteration.	
 		float ptl;
 		//! Remainder from last erase iteration.
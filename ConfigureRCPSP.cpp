@@ -27,10 +27,78 @@ namespace ConfigureRCPSP {
 	/* SCHEDULE SOLVER SETTINGS */
 	uint32_t NUMBER_OF_ITERATIONS = DEFAULT_NUMBER_OF_ITERATIONS;
 	uint32_t MAXIMAL_NUMBER_OF_ITERATIONS_SINCE_BEST = DEFAULT_MAXIMAL_NUMBER_OF_ITERATIONS_SINCE_BEST;
+	uint32_t CYCLE_DETECTION_HISTORY = DEFAULT_CYCLE_DETECTION_HISTORY;
+	uint32_t PRIORITY_RULE_PASSES = DEFAULT_PRIORITY_RULE_PASSES;
 	uint32_t SWAP_RANGE = DEFAULT_SWAP_RANGE;
 	uint32_t SHIFT_RANGE = DEFAULT_SHIFT_RANGE;
 	uint32_t DIVERSIFICATION_SWAPS = DEFAULT_DIVERSIFICATION_SWAPS;
+	bool SPECULATIVE_EVALUATION = (DEFAULT_SPECULATIVE_EVALUATION == 1 ? true : false);
+	bool LOWER_BOUND_FILTER = (DEFAULT_LOWER_BOUND_FILTER == 1 ? true : false);
+	ScheduleGenerationScheme SCHEDULE_GENERATION_SCHEME = DEFAULT_SCHEDULE_GENERATION_SCHEME;
+	bool CRITICAL_NEIGHBOURHOOD = (DEFAULT_CRITICAL_NEIGHBOURHOOD == 1 ? true : false);
+	uint32_t CRITICAL_NEIGHBOURHOOD_FULL_SCAN_INTERVAL = DEFAULT_CRITICAL_NEIGHBOURHOOD_FULL_SCAN_INTERVAL;
+	uint32_t NEIGHBOURHOOD_SAMPLE_PERCENTAGE = DEFAULT_NEIGHBOURHOOD_SAMPLE_PERCENTAGE;
+	uint32_t EVALUATION_CACHE_SIZE = DEFAULT_EVALUATION_CACHE_SIZE;
+	bool RENUMBER_ACTIVITIES = (DEFAULT_RENUMBER_ACTIVITIES == 1 ? true : false);
+	uint32_t RANDOM_SEED = DEFAULT_RANDOM_SEED;
 	bool WRITE_GRAPH = (DEFAULT_WRITE_GRAPH == 1 ? true : false);
 	bool WRITE_RESULT_FILE = (DEFAULT_WRITE_RESULT_FILE == 1 ? true : false);
+	double TIME_LIMIT = DEFAULT_TIME_LIMIT;
+	/* ISLAND MODEL SETTINGS */
+	uint32_t NUMBER_OF_ISLANDS = DEFAULT_NUMBER_OF_ISLANDS;
+	uint32_t THREADS_PER_ISLAND = DEFAULT_THREADS_PER_ISLAND;
+	uint32_t ISLAND_EXCHANGE_INTERVAL = DEFAULT_ISLAND_EXCHANGE_INTERVAL;
+	bool ASYNCHRONOUS_SEARCH = (DEFAULT_ASYNCHRONOUS_SEARCH == 1 ? true : false);
+	bool PORTFOLIO_MODE = (DEFAULT_PORTFOLIO_MODE == 1 ? true : false);
+	bool NUMA_AWARE = (DEFAULT_NUMA_AWARE == 1 ? true : false);
+	/* BATCH MODE SETTINGS */
+	bool BATCH_MODE = (DEFAULT_BATCH_MODE == 1 ? true : false);
+	uint32_t BATCH_LARGE_INSTANCE_THRESHOLD = DEFAULT_BATCH_LARGE_INSTANCE_THRESHOLD;
+	uint32_t BATCH_TEAM_SIZE = DEFAULT_BATCH_TEAM_SIZE;
+	/* SERVER MODE SETTINGS */
+	uint32_t SERVER_WORKERS = DEFAULT_SERVER_WORKERS;
+
+	SolverConfig currentSolverConfig()	{
+		SolverConfig config;
+		config.tabuListType = TABU_LIST_TYPE;
+		config.simpleTabuListSize = SIMPLE_TABU_LIST_SIZE;
+		config.advancedTabuRandomizeEraseAmount = ADVANCED_TABU_RANDOMIZE_ERASE_AMOUNT;
+		config.advancedTabuSwapLife = ADVANCED_TABU_SWAP_LIFE;
+		config.advancedTabuShiftLife = ADVANCED_TABU_SHIFT_LIFE;
+		config.maximalNumberOfIterationsSinceBest = MAXIMAL_NUMBER_OF_ITERATIONS_SINCE_BEST;
+		config.cycleDetectionHistory = CYCLE_DETECTION_HISTORY;
+		config.priorityRulePasses = PRIORITY_RULE_PASSES;
+		config.swapRange = SWAP_RANGE;
+		config.shiftRange = SHIFT_RANGE;
+		config.diversificationSwaps = DIVERSIFICATION_SWAPS;
+		config.speculativeEvaluation = SPECULATIVE_EVALUATION;
+		config.lowerBoundFilter = LOWER_BOUND_FILTER;
+		config.scheduleGenerationScheme = SCHEDULE_GENERATION_SCHEME;
+		config.criticalNeighbourhood = CRITICAL_NEIGHBOURHOOD;
+		config.criticalNeighbourhoodFullScanInterval = CRITICAL_NEIGHBOURHOOD_FULL_SCAN_INTERVAL;
+		config.neighbourhoodSamplePercentage = NEIGHBOURHOOD_SAMPLE_PERCENTAGE;
+		config.evaluationCacheSize = EVALUATION_CACHE_SIZE;
+		config.renumberActivities = RENUMBER_ACTIVITIES;
+		config.randomSeed = RANDOM_SEED;
+		config.numberOfIslands = NUMBER_OF_ISLANDS;
+		config.threadsPerIsland = THREADS_PER_ISLAND;
+		config.islandExchangeInterval = ISLAND_EXCHANGE_INTERVAL;
+		config.asynchronousSearch = ASYNCHRONOUS_SEARCH;
+		config.portfolioMode = PORTFOLIO_MODE;
+		config.numaAware = NUMA_AWARE;
+		return config;
+	}
+}
+
+SolverConfig::SolverConfig() : tabuListType(TABU_LIST), simpleTabuListSize(TABU_LIST_SIZE), advancedTabuRandomizeEraseAmount(RANDOMIZE_ERASE_AMOUNT),
+	advancedTabuSwapLife(SWAP_LIFE), advancedTabuShiftLife(SHIFT_LIFE), maximalNumberOfIterationsSinceBest(DEFAULT_MAXIMAL_NUMBER_OF_ITERATIONS_SINCE_BEST),
+	cycleDetectionHistory(DEFAULT_CYCLE_DETECTION_HISTORY), priorityRulePasses(DEFAULT_PRIORITY_RULE_PASSES), swapRange(DEFAULT_SWAP_RANGE),
+	shiftRange(DEFAULT_SHIFT_RANGE), diversificationSwaps(DEFAULT_DIVERSIFICATION_SWAPS), speculativeEvaluation(DEFAULT_SPECULATIVE_EVALUATION == 1),
+	lowerBoundFilter(DEFAULT_LOWER_BOUND_FILTER == 1), scheduleGenerationScheme(DEFAULT_SCHEDULE_GENERATION_SCHEME),
+	criticalNeighbourhood(DEFAULT_CRITICAL_NEIGHBOURHOOD == 1), criticalNeighbourhoodFullScanInterval(DEFAULT_CRITICAL_NEIGHBOURHOOD_FULL_SCAN_INTERVAL),
+	neighbourhoodSamplePercentage(DEFAULT_NEIGHBOURHOOD_SAMPLE_PERCENTAGE), evaluationCacheSize(DEFAULT_EVALUATION_CACHE_SIZE),
+	renumberActivities(DEFAULT_RENUMBER_ACTIVITIES == 1), randomSeed(DEFAULT_RANDOM_SEED), numberOfIslands(DEFAULT_NUMBER_OF_ISLANDS), threadsPerIsland(DEFAULT_THREADS_PER_ISLAND),
+	islandExchangeInterval(DEFAULT_ISLAND_EXCHANGE_INTERVAL), asynchronousSearch(DEFAULT_ASYNCHRONOUS_SEARCH == 1), portfolioMode(DEFAULT_PORTFOLIO_MODE == 1),
+	numaAware(DEFAULT_NUMA_AWARE == 1)	{
 }
 
@@ -28,6 +28,79 @@
 #include "DefaultConfigureRCPSP.h"
 
 /*!
+ * The configuration is a value owned by each solver and its tabu lists, so the solvers of one process can use different settings
+ * and they can run concurrently. The default constructor sets the default values of DefaultConfigureRCPSP.h.
+ * \struct SolverConfig
+ * \brief The settings of the tabu search and the island model of one solver.
+ */
+struct SolverConfig {
+	//! Initialise the settings to the default values.
+	SolverConfig();
+
+	/* TABU LIST SETTINGS */
+
+	//! Tabu list type.
+	TabuType tabuListType;
+	//! Simple tabu list size.
+	uint32_t simpleTabuListSize;
+	//! Relative amount of erased elements of advanced tabu list when diversification take place.
+	double advancedTabuRandomizeEraseAmount;
+	//! Life expectancy of the swap move at the advanced tabu list.
+	uint32_t advancedTabuSwapLife;
+	//! Life expectancy of the shift move at the advanced tabu list.
+	uint32_t advancedTabuShiftLife;
+
+	/* SCHEDULE SOLVER SETTINGS */
+
+	//! Maximal number of iterations without improving of the best solution.
+	uint32_t maximalNumberOfIterationsSinceBest;
+	//! The number of the recently visited orders that are checked for a cycle. Zero disables the cycle detection.
+	uint32_t cycleDetectionHistory;
+	//! The number of passes of the priority rule heuristic that creates the initial order. Zero keeps the level order.
+	uint32_t priorityRulePasses;
+	//! Maximal distance between swapped activities.
+	uint32_t swapRange;
+	//! Maximal number of activities that could be skipped by other activity when shift move is performed.
+	uint32_t shiftRange;
+	//! Number of diversification swaps.
+	uint32_t diversificationSwaps;
+	//! Do idle threads speculatively evaluate the next neighbourhood?
+	bool speculativeEvaluation;
+	//! Are the moves filtered by the lower bounds of their costs?
+	bool lowerBoundFilter;
+	//! The schedule generation scheme that decodes the orders of the neighbourhood.
+	ScheduleGenerationScheme scheduleGenerationScheme;
+	//! Is the neighbourhood restricted to the moves of the critical activities?
+	bool criticalNeighbourhood;
+	//! The interval of the full neighbourhood scans if the critical neighbourhood is enabled.
+	uint32_t criticalNeighbourhoodFullScanInterval;
+	//! Percentage of the neighbourhood rows that are evaluated in each iteration.
+	uint32_t neighbourhoodSamplePercentage;
+	//! The maximal number of entries of the cache of the evaluated orders. Zero disables the cache.
+	uint32_t evaluationCacheSize;
+	//! Are the activities internally renumbered in the level order?
+	bool renumberActivities;
+	//! The seed of the random number generators of the trajectories. Zero means a seed derived from the current time.
+	uint32_t randomSeed;
+
+	/* ISLAND MODEL SETTINGS */
+
+	//! Number of independent search trajectories (islands).
+	uint32_t numberOfIslands;
+	//! Number of threads per island. Zero means that threads are divided equally among islands.
+	uint32_t threadsPerIsland;
+	//! Number of iterations between two exchanges of the best orders among islands.
+	uint32_t islandExchangeInterval;
+	//! Do the islands run asynchronously as independent walkers?
+	bool asynchronousSearch;
+	//! Do the islands use different settings of the tabu search?
+	bool portfolioMode;
+	//! Are the islands bound to NUMA nodes with the replicated instance data?
+	bool numaAware;
+};
+
+/*!
+ * The variables are set by the command line switches, the solvers read only their own SolverConfig.
  * \namespace ConfigureRCPSP
  * \brief Configurable extern global variables are defined at this namespace.
  */
@@ -52,16 +125,72 @@ namespace ConfigureRCPSP {
 	extern uint32_t NUMBER_OF_ITERATIONS;
 	//! Maximal number of iterations without improving of the best solution.
 	extern uint32_t MAXIMAL_NUMBER_OF_ITERATIONS_SINCE_BEST;
+	//! The number of the recently visited orders that are checked for a cycle. Zero disables the cycle detection.
+	extern uint32_t CYCLE_DETECTION_HISTORY;
+	//! The number of passes of the priority rule heuristic that creates the initial order. Zero keeps the level order.
+	extern uint32_t PRIORITY_RULE_PASSES;
 	//! Maximal distance between swapped activities.
 	extern uint32_t SWAP_RANGE;
 	//! Maximal number of activities that could be skipped by other activity when shift move is performed.
 	extern uint32_t SHIFT_RANGE;
 	//! Number of diversification swaps.
 	extern uint32_t DIVERSIFICATION_SWAPS;
+	//! Do idle threads speculatively evaluate the next neighbourhood?
+	extern bool SPECULATIVE_EVALUATION;
+	//! Are the moves filtered by the lower bounds of their costs?
+	extern bool LOWER_BOUND_FILTER;
+	//! The schedule generation scheme that decodes the orders of the neighbourhood.
+	extern ScheduleGenerationScheme SCHEDULE_GENERATION_SCHEME;
+	//! Is the neighbourhood restricted to the moves of the critical activities?
+	extern bool CRITICAL_NEIGHBOURHOOD;
+	//! The interval of the full neighbourhood scans if the critical neighbourhood is enabled.
+	extern uint32_t CRITICAL_NEIGHBOURHOOD_FULL_SCAN_INTERVAL;
+	//! Percentage of the neighbourhood rows that are evaluated in each iteration.
+	extern uint32_t NEIGHBOURHOOD_SAMPLE_PERCENTAGE;
+	//! The maximal number of entries of the cache of the evaluated orders. Zero disables the cache.
+	extern uint32_t EVALUATION_CACHE_SIZE;
+	//! Are the activities internally renumbered in the level order?
+	extern bool RENUMBER_ACTIVITIES;
+	//! The seed of the random number generators. Zero means a seed derived from the current time.
+	extern uint32_t RANDOM_SEED;
 	//! Do you want a write csv file? Makespan criterion dependent on number of iterations.
 	extern bool WRITE_GRAPH;
 	//! Do you want to write a result file with the encoded best schedule? 
 	extern bool WRITE_RESULT_FILE;
+	//! Wall clock time limit of one instance at seconds. Zero means no limit.
+	extern double TIME_LIMIT;
+
+	/* ISLAND MODEL SETTINGS */
+
+	//! Number of independent search trajectories (islands).
+	extern uint32_t NUMBER_OF_ISLANDS;
+	//! Number of threads per island. Zero means that threads are divided equally among islands.
+	extern uint32_t THREADS_PER_ISLAND;
+	//! Number of iterations between two exchanges of the best orders among islands.
+	extern uint32_t ISLAND_EXCHANGE_INTERVAL;
+	//! Do the islands run asynchronously as independent walkers?
+	extern bool ASYNCHRONOUS_SEARCH;
+	//! Do the islands use different settings of the tabu search?
+	extern bool PORTFOLIO_MODE;
+	//! Are the islands bound to NUMA nodes with the replicated instance data?
+	extern bool NUMA_AWARE;
+
+	/* BATCH MODE SETTINGS */
+
+	//! Are the input instances solved concurrently?
+	extern bool BATCH_MODE;
+	//! Instances with more activities are solved by a team of threads in the batch mode.
+	extern uint32_t BATCH_LARGE_INSTANCE_THRESHOLD;
+	//! Number of threads solving one large instance. Zero means all threads.
+	extern uint32_t BATCH_TEAM_SIZE;
+
+	/* SERVER MODE SETTINGS */
+
+	//! Number of instances solved concurrently by the server. Zero means one instance per hardware thread.
+	extern uint32_t SERVER_WORKERS;
+
+	//! Return the configuration of a solver with the current values of the global variables, e.g. the values set by the command line.
+	SolverConfig currentSolverConfig();
 }
 
 #endif
@@ -40,5 +40,10 @@ enum EvaluationAlgorithm {
 	CAPACITY_RESOLUTION, TIME_RESOLUTION
 };
 
+//! The schedule generation schemes that decode the orders of the neighbourhood.
+enum ScheduleGenerationScheme {
+	SERIAL_SGS, PARALLEL_SGS, MIXED_SGS
+};
+
 #endif
 
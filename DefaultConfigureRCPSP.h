@@ -46,16 +46,72 @@
 #define DEFAULT_NUMBER_OF_ITERATIONS 1000
 //! Maximal number of iterations since best solution found. (diversification purposes)
 #define DEFAULT_MAXIMAL_NUMBER_OF_ITERATIONS_SINCE_BEST 300
+//! The number of the recently visited orders whose hashes are checked for a cycle of the search. (0 == cycle detection disabled)
+#define DEFAULT_CYCLE_DETECTION_HISTORY 32
+//! The number of passes of the initial priority rule heuristic, the passes after the deterministic rules are regret-biased samples. (0 == level order)
+#define DEFAULT_PRIORITY_RULE_PASSES 100
 //! Define maximal distance of swapped activities.
 #define DEFAULT_SWAP_RANGE 60
 //! Define maximal shift range of any activity.
 #define DEFAULT_SHIFT_RANGE 0
 //! Number of diversification swaps.
 #define DEFAULT_DIVERSIFICATION_SWAPS 10
+//! Idle threads speculatively evaluate the neighbourhood of the best candidate move. (1 == true, 0 == false)
+#define DEFAULT_SPECULATIVE_EVALUATION 0
+//! The moves whose lower bound of the cost shows that they cannot be selected are not evaluated. (1 == true, 0 == false)
+#define DEFAULT_LOWER_BOUND_FILTER 0
+//! The schedule generation scheme of the neighbourhood evaluation: SERIAL_SGS, PARALLEL_SGS or MIXED_SGS (the better of both).
+#define DEFAULT_SCHEDULE_GENERATION_SCHEME SERIAL_SGS
+//! Only the moves of the activities on the critical chains of the current schedule are evaluated. (1 == true, 0 == false)
+#define DEFAULT_CRITICAL_NEIGHBOURHOOD 0
+//! Every n-th iteration evaluates the full neighbourhood if the critical neighbourhood is enabled.
+#define DEFAULT_CRITICAL_NEIGHBOURHOOD_FULL_SCAN_INTERVAL 10
+//! Percentage of the neighbourhood rows (moved activities) that are randomly sampled and evaluated in each iteration. (value 1-100)
+#define DEFAULT_NEIGHBOURHOOD_SAMPLE_PERCENTAGE 100
+//! The maximal number of entries of the cache of the evaluated orders, it is rounded up to the power of two. (0 == cache disabled)
+//! The table has 16 bytes per entry and is allocated by each solver, it is smaller if the iteration budget cannot fill it.
+#define DEFAULT_EVALUATION_CACHE_SIZE 65536
+//! If 1 then the activities are internally renumbered in the level order of the precedence graph. The output uses the original ids. (1 == true, 0 == false)
+#define DEFAULT_RENUMBER_ACTIVITIES 0
+//! The seed of the random number generators of the search trajectories. If 0 then the seed is derived from the current time.
+#define DEFAULT_RANDOM_SEED 0
 //! Do you want to write makespan criterion graph (independent variable is iteration number). As a result you obtain csv file. (1 == true, 0 == false)
 #define DEFAULT_WRITE_GRAPH 0
 //! If you want to write the best schedule to a file set this variable to 1.
 #define DEFAULT_WRITE_RESULT_FILE 0
+//! Wall clock time limit of one instance at seconds. The best found schedule is returned when the limit is reached. (0 == no limit)
+#define DEFAULT_TIME_LIMIT 0
+
+/* ISLAND MODEL */
+
+//! Number of independent search trajectories (islands). Value 1 means that all threads evaluate the neighbourhood of one trajectory.
+#define DEFAULT_NUMBER_OF_ISLANDS 1
+//! Number of threads that evaluate the neighbourhood of one island. If 0 then available threads are divided equally among islands.
+#define DEFAULT_THREADS_PER_ISLAND 0
+//! Number of iterations after which the islands exchange their best orders through the elite pool.
+#define DEFAULT_ISLAND_EXCHANGE_INTERVAL 50
+//! If 1 then the islands (walkers) run without barriers and share only the best makespan record and the elite pool. (1 == true, 0 == false)
+#define DEFAULT_ASYNCHRONOUS_SEARCH 0
+//! If 1 then the islands run different tabu lists, tabu list sizes and swap ranges. (1 == true, 0 == false)
+#define DEFAULT_PORTFOLIO_MODE 0
+//! If 1 then the threads of the islands are bound to NUMA nodes and each node has its own copy of the instance data. (1 == true, 0 == false)
+#define DEFAULT_NUMA_AWARE 0
+
+/* BATCH MODE */
+
+//! If 1 then the input instances are solved concurrently, else one after another. (1 == true, 0 == false)
+#define DEFAULT_BATCH_MODE 0
+//! Instances with more activities than this threshold are solved by a team of threads in the batch mode, smaller ones by one thread.
+#define DEFAULT_BATCH_LARGE_INSTANCE_THRESHOLD 62
+//! Number of threads solving one large instance in the batch mode. If 0 then all threads solve one large instance.
+#define DEFAULT_BATCH_TEAM_SIZE 0
+
+/* SERVER MODE */
+
+//! Number of instances that are solved concurrently by the server, the threads are divided among them. If 0 then each hardware thread solves one instance.
+#define DEFAULT_SERVER_WORKERS 0
+//! The maximal size of one instance sent to the server at bytes.
+#define DEFAULT_SERVER_MAX_REQUEST_SIZE 67108864
 
 #endif
 
@@ -0,0 +1,132 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+#include "ElitePool.h"
+
+using namespace std;
+
+ElitePool::ElitePool(const uint32_t& numberOfActivities, const uint32_t& capacity) : numberOfActivities(numberOfActivities), capacity(capacity)	{
+	if (capacity == 0)
+		throw invalid_argument("ElitePool::ElitePool: The capacity of the elite pool has to be positive!");
+	#ifdef _OPENMP
+	omp_init_lock(&poolLock);
+	#endif
+}
+
+bool ElitePool::addSolution(const uint32_t * const& order, const uint32_t& cost)	{
+	#ifdef _OPENMP
+	omp_set_lock(&poolLock);
+	#endif
+
+	bool isNewElite = (elites.size() < capacity || elites.back().cost > cost);
+	// Duplicate orders would decrease the diversity of the pool.
+	for (vector<EliteSolution>::const_iterator it = elites.begin(); isNewElite && it != elites.end() && it->cost <= cost; ++it)	{
+		if (it->cost == cost && equal(order, order+numberOfActivities, it->order))
+			isNewElite = false;
+	}
+
+	if (isNewElite == true)
+		insertSolution(order, cost);
+
+	#ifdef _OPENMP
+	omp_unset_lock(&poolLock);
+	#endif
+
+	return isNewElite;
+}
+
+void ElitePool::insertSolution(const uint32_t * const& order, const uint32_t& cost)	{
+	EliteSolution elite;
+	if (elites.size() == capacity)	{
+		// The worst order is replaced.
+		elite.order = elites.back().order;
+		elites.pop_back();
+	} else {
+		elite.order = new uint32_t[numberOfActivities];
+	}
+
+	elite.cost = cost;
+	copy(order, order+numberOfActivities, elite.order);
+
+	vector<EliteSolution>::iterator pos = elites.begin();
+	while (pos != elites.end() && pos->cost <= cost)
+		++pos;
+	elites.insert(pos, elite);
+}
+
+const EliteSolution* ElitePool::getRandomBetterSolution(const uint32_t& cost, const uint32_t& randomNumber) const	{
+	uint32_t numberOfBetter = 0;
+	while (numberOfBetter < elites.size() && elites[numberOfBetter].cost < cost)
+		++numberOfBetter;
+
+	if (numberOfBetter > 0)
+		return &elites[randomNumber % numberOfBetter];
+	else
+		return NULL;
+}
+
+bool ElitePool::copyRandomBetterSolution(const uint32_t& cost, uint32_t * const& order, uint32_t& eliteCost, const uint32_t& randomNumber)	{
+	#ifdef _OPENMP
+	omp_set_lock(&poolLock);
+	#endif
+
+	const EliteSolution *elite = getRandomBetterSolution(cost, randomNumber);
+	if (elite != NULL)	{
+		copy(elite->order, elite->order+numberOfActivities, order);
+		eliteCost = elite->cost;
+	}
+
+	#ifdef _OPENMP
+	omp_unset_lock(&poolLock);
+	#endif
+
+	return (elite != NULL);
+}
+
+uint32_t ElitePool::size()	{
+	#ifdef _OPENMP
+	omp_set_lock(&poolLock);
+	#endif
+	uint32_t numberOfElites = elites.size();
+	#ifdef _OPENMP
+	omp_unset_lock(&poolLock);
+	#endif
+	return numberOfElites;
+}
+
+void ElitePool::clear()	{
+	#ifdef _OPENMP
+	omp_set_lock(&poolLock);
+	#endif
+	for (vector<EliteSolution>::const_iterator it = elites.begin(); it != elites.end(); ++it)
+		delete[] it->order;
+	elites.clear();
+	#ifdef _OPENMP
+	omp_unset_lock(&poolLock);
+	#endif
+}
+
+ElitePool::~ElitePool()	{
+	for (vector<EliteSolution>::const_iterator it = elites.begin(); it != elites.end(); ++it)
+		delete[] it->order;
+	#ifdef _OPENMP
+	omp_destroy_lock(&poolLock);
+	#endif
+}
+
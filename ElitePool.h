@@ -0,0 +1,121 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef HLIDAC_PES_ELITE_POOL_H
+#define HLIDAC_PES_ELITE_POOL_H
+
+/*!
+ * \file ElitePool.h
+ * \author Libor Bukata
+ * \brief The pool of the best found activity orders.
+ */
+
+#include <vector>
+#include <stdint.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*!
+ * \struct EliteSolution
+ * \brief An item of the elite pool.
+ */
+struct EliteSolution {
+	//! The makespan of the stored order.
+	uint32_t cost;
+	//! The order of activities.
+	uint32_t *order;
+};
+
+/*!
+ * The elite pool keeps a fixed number of distinct activity orders with the lowest makespan.
+ * Independent search trajectories (islands) put their best orders to the pool and pick
+ * better orders from the pool to continue the search from them. The methods addSolution, copyRandomBetterSolution
+ * and size can be called concurrently by asynchronous walkers.
+ * \class ElitePool
+ * \brief The pool of distinct elite solutions sorted by the makespan.
+ */
+class ElitePool {
+	public:
+		/*!
+		 * \param numberOfActivities The number of activities of the project, i.e. the length of the stored orders.
+		 * \param capacity The maximal number of stored orders.
+		 * \exception invalid_argument The capacity of the pool has to be positive.
+		 * \brief Create an empty elite pool.
+		 */
+		ElitePool(const uint32_t& numberOfActivities, const uint32_t& capacity);
+
+		/*!
+		 * \param order The order of activities.
+		 * \param cost The makespan of the order.
+		 * \return True if the order was stored else false.
+		 * \brief The copy of the order is stored if it is not in the pool yet and it is better than the worst stored order.
+		 */
+		bool addSolution(const uint32_t * const& order, const uint32_t& cost);
+		/*!
+		 * \param cost The makespan that has to be improved.
+		 * \param randomNumber The random number that selects one of the better solutions, e.g. from the generator of the caller.
+		 * \return A randomly selected elite solution with the makespan lower than the cost or NULL if no such solution exists.
+		 * \brief It selects a random elite solution that is better than the given makespan.
+		 * \warning The returned solution is valid only until the next call of addSolution, it is not suitable for concurrent access.
+		 */
+		const EliteSolution* getRandomBetterSolution(const uint32_t& cost, const uint32_t& randomNumber) const;
+		/*!
+		 * \param cost The makespan that has to be improved.
+		 * \param order The order of the selected elite solution is copied to this array.
+		 * \param eliteCost The makespan of the selected elite solution.
+		 * \param randomNumber The random number that selects one of the better solutions.
+		 * \return True if a better elite solution was copied else false.
+		 * \brief The thread safe variant of getRandomBetterSolution.
+		 */
+		bool copyRandomBetterSolution(const uint32_t& cost, uint32_t * const& order, uint32_t& eliteCost, const uint32_t& randomNumber);
+		//! Return the number of stored orders.
+		uint32_t size();
+		//! All stored orders are removed, e.g. if the instance was changed and their makespans are not valid.
+		void clear();
+
+		//! Free all stored orders.
+		~ElitePool();
+
+	private:
+
+		/*!
+		 * \param order The order of activities.
+		 * \param cost The makespan of the order.
+		 * \brief The copy of the order is inserted to the sorted pool, the worst order is replaced if the pool is full.
+		 */
+		void insertSolution(const uint32_t * const& order, const uint32_t& cost);
+
+		//! Copy constructor is forbidden.
+		ElitePool(const ElitePool&);
+		//! Assignment operator is forbidden.
+		ElitePool& operator=(const ElitePool&);
+
+		//! The length of the stored orders.
+		const uint32_t numberOfActivities;
+		//! The maximal number of stored orders.
+		const uint32_t capacity;
+		//! Stored orders sorted by the makespan in the non-decreasing order.
+		std::vector<EliteSolution> elites;
+		#ifdef _OPENMP
+		//! It guards the stored orders against concurrent modifications.
+		omp_lock_t poolLock;
+		#endif
+};
+
+#endif
+
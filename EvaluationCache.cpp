@@ -0,0 +1,98 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <stdexcept>
+#include "EvaluationCache.h"
+
+using namespace std;
+
+//! The valid flag of the cache entry.
+#define EVALUATION_CACHE_VALID_ENTRY (((uint64_t) 1) << 32)
+
+EvaluationCache::EvaluationCache(const uint32_t& numberOfEntries)	{
+	if (numberOfEntries == 0)
+		throw invalid_argument("EvaluationCache::EvaluationCache: The number of entries has to be positive!");
+
+	uint64_t tableSize = 1;
+	while (tableSize < numberOfEntries)
+		tableSize <<= 1;
+
+	indexMask = tableSize-1;
+	entries = new CacheEntry[tableSize];
+	generation = generationKey = 0;
+	clear();
+}
+
+uint64_t EvaluationCache::hashOfOrder(const uint32_t * const& order, const uint32_t& numberOfActivities)	{
+	uint64_t hash = 0;
+	for (uint32_t position = 0; position < numberOfActivities; ++position)
+		hash ^= mix((((uint64_t) position) << 32) | order[position]);
+	return hash;
+}
+
+uint64_t EvaluationCache::changeHash(const uint64_t& hash, const uint32_t * const& originalOrder, const uint32_t * const& changedOrder, const uint32_t& position)	{
+	return hash ^ mix((((uint64_t) position) << 32) | originalOrder[position]) ^ mix((((uint64_t) position) << 32) | changedOrder[position]);
+}
+
+uint64_t EvaluationCache::toggleKey(const uint64_t& hash, const uint32_t * const& order, const uint32_t& position)	{
+	return hash ^ mix((((uint64_t) position) << 32) | order[position]);
+}
+
+uint64_t EvaluationCache::evaluationKey(const uint64_t& orderHash, const uint32_t& costOfBestSchedule, const uint32_t& algorithm) const	{
+	return orderHash ^ mix(~((((uint64_t) costOfBestSchedule) << 8) | algorithm)) ^ generationKey;
+}
+
+bool EvaluationCache::find(const uint64_t& key, uint32_t& cost) const	{
+	const CacheEntry& entry = entries[key & indexMask];
+	uint64_t data = entry.data.load(memory_order_relaxed);
+	uint64_t check = entry.check.load(memory_order_relaxed);
+	if ((data & EVALUATION_CACHE_VALID_ENTRY) != 0 && (check ^ data) == key)	{
+		cost = (uint32_t) data;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+void EvaluationCache::insert(const uint64_t& key, const uint32_t& cost)	{
+	CacheEntry& entry = entries[key & indexMask];
+	uint64_t data = EVALUATION_CACHE_VALID_ENTRY | cost;
+	entry.data.store(data, memory_order_relaxed);
+	entry.check.store(key ^ data, memory_order_relaxed);
+}
+
+uint64_t EvaluationCache::mix(uint64_t value)	{
+	value += 0x9e3779b97f4a7c15ULL;
+	value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+	return value ^ (value >> 31);
+}
+
+void EvaluationCache::invalidate()	{
+	generationKey = mix(++generation);
+}
+
+void EvaluationCache::clear()	{
+	for (uint64_t idx = 0; idx <= indexMask; ++idx)	{
+		entries[idx].check.store(0, memory_order_relaxed);
+		entries[idx].data.store(0, memory_order_relaxed);
+	}
+}
+
+EvaluationCache::~EvaluationCache()	{
+	delete[] entries;
+}
+
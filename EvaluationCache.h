@@ -0,0 +1,135 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef HLIDAC_PES_EVALUATION_CACHE_H
+#define HLIDAC_PES_EVALUATION_CACHE_H
+
+/*!
+ * \file EvaluationCache.h
+ * \author Libor Bukata
+ * \brief The cache of the evaluated activity orders.
+ */
+
+#include <atomic>
+#include <stdint.h>
+
+/*!
+ * The orders are identified by the Zobrist hash, i.e. the xor of the pseudo-random keys of all (position, activity) pairs.
+ * The hash of a neighbour order is derived from the hash of the current order by replacing the keys of the changed positions,
+ * i.e. two positions for the swap move. The cache is a fixed-size table without locks, each entry is verified by the xor
+ * of the key and the stored data, so an entry torn by concurrent writes is not found. The newer entry always replaces the older one.
+ * \class EvaluationCache
+ * \brief The concurrent cache that maps the hashes of the evaluated orders to their costs.
+ */
+class EvaluationCache {
+	public:
+		/*!
+		 * \param numberOfEntries The minimal number of entries, it is rounded up to the power of two.
+		 * \exception invalid_argument The number of entries has to be positive.
+		 * \brief Create an empty cache.
+		 */
+		EvaluationCache(const uint32_t& numberOfEntries);
+
+		/*!
+		 * \param order The order of activities.
+		 * \param numberOfActivities The length of the order.
+		 * \return The Zobrist hash of the order.
+		 */
+		static uint64_t hashOfOrder(const uint32_t * const& order, const uint32_t& numberOfActivities);
+		/*!
+		 * \param hash The hash of the original order.
+		 * \param originalOrder The original order.
+		 * \param changedOrder The changed order.
+		 * \param position The position whose activity was changed.
+		 * \return The hash with the key of the position replaced.
+		 * \brief It updates the hash in the constant time if the activity at the position is changed.
+		 */
+		static uint64_t changeHash(const uint64_t& hash, const uint32_t * const& originalOrder, const uint32_t * const& changedOrder, const uint32_t& position);
+		/*!
+		 * \param hash The hash of the order.
+		 * \param order The order of activities.
+		 * \param position The position of the activity.
+		 * \return The hash with the key of the activity at the position removed if it was included, else added.
+		 * \brief An order changed in place is rehashed by toggling the keys of the changed positions before and after the change.
+		 */
+		static uint64_t toggleKey(const uint64_t& hash, const uint32_t * const& order, const uint32_t& position);
+		/*!
+		 * \param orderHash The hash of the evaluated order.
+		 * \param costOfBestSchedule The best makespan, it determines the penalty of the evaluated order.
+		 * \param algorithm The evaluation algorithm, the algorithms may return different schedules.
+		 * \return The key of the cache entry, it also depends on the generation of the cache (see invalidate).
+		 */
+		uint64_t evaluationKey(const uint64_t& orderHash, const uint32_t& costOfBestSchedule, const uint32_t& algorithm) const;
+
+		/*!
+		 * \param key The key of the evaluation.
+		 * \param cost The cached cost is written to this variable if it is found.
+		 * \return True if the key was found else false.
+		 */
+		bool find(const uint64_t& key, uint32_t& cost) const;
+		/*!
+		 * \param key The key of the evaluation.
+		 * \param cost The cost of the evaluated order.
+		 * \brief The cost is stored, the entry with the same index is replaced.
+		 */
+		void insert(const uint64_t& key, const uint32_t& cost);
+		/*!
+		 * \brief All entries are invalidated, e.g. if the instance was changed. The generation of the cache is increased,
+		 * the keys of the old entries differ from the new keys, so the table is not cleared.
+		 * It must not be called concurrently with the other methods.
+		 */
+		void invalidate();
+		//! It returns the number of entries of the table.
+		uint64_t getNumberOfEntries() const { return indexMask+1; }
+
+		//! Free the table of the entries.
+		~EvaluationCache();
+
+	private:
+
+		//! Copy constructor is forbidden.
+		EvaluationCache(const EvaluationCache&);
+		//! Assignment operator is forbidden.
+		EvaluationCache& operator=(const EvaluationCache&);
+
+		//! It returns the pseudo-random 64-bit mix of the value (the finalizer of the SplitMix64 generator).
+		static uint64_t mix(uint64_t value);
+		//! All entries of the table are cleared.
+		void clear();
+
+		/*!
+		 * \struct CacheEntry
+		 * \brief The entry of the cache.
+		 */
+		struct CacheEntry {
+			//! The xor of the key and the data.
+			std::atomic<uint64_t> check;
+			//! The valid flag (bit 32) and the cost (bits 0-31).
+			std::atomic<uint64_t> data;
+		};
+
+		//! The index of the entry is the key masked by this value.
+		uint64_t indexMask;
+		//! The table of the entries.
+		CacheEntry *entries;
+		//! The number of invalidations of the cache.
+		uint64_t generation;
+		//! The mixed generation that is folded into the keys.
+		uint64_t generationKey;
+};
+
+#endif
+
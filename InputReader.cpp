@@ -21,6 +21,7 @@
 #include <sstream>
 #include <string>
 #include <stdexcept>
+#include <vector>
 #include "InputReader.h"
 
 using namespace std;
@@ -195,12 +196,43 @@ void InputReader::readFromStream(istream& IN) {
 	}
 
 	// Check if resources are sufficient for activities.
+	if (!resourcesSufficient())
+		throw runtime_error("InputReader::readFromStream: Suggested resources are insufficient for activities requirement!");
+	if (!precedenceGraphValid())
+		throw runtime_error("InputReader::readFromStream: The precedence graph has to be acyclic with the only source (the first activity) and the only sink (the last activity)!");
+}
+
+void InputReader::readFromArrays(const uint32_t& numberOfActivities, const uint32_t& numberOfResources, const uint32_t * const& durations,
+		const uint32_t * const& capacities, const uint32_t * const& requirements, const uint32_t * const& numberOfSuccessors, const uint32_t * const& successors)	{
+	freeInstanceData();
+
+	if (numberOfActivities < 2 || numberOfResources == 0)
+		throw invalid_argument("InputReader::readFromArrays: Invalid value of number of activities or number of resources!");
+
+	this->numberOfActivities = numberOfActivities;
+	totalNumberOfResources = numberOfResources;
+	allocateBaseArrays();
+
+	copy(durations, durations+numberOfActivities, activitiesDuration);
+	copy(capacities, capacities+numberOfResources, capacityOfResources);
+	copy(requirements, requirements+numberOfActivities*numberOfResources, activitiesRequiredResources[0]);
+	copy(numberOfSuccessors, numberOfSuccessors+numberOfActivities, activitiesNumberOfSuccessors);
+
+	const uint32_t *successorsOfActivity = successors;
 	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
-		for (uint32_t resourceId = 0; resourceId < totalNumberOfResources; ++resourceId)	{
-			if (activitiesRequiredResources[activityId][resourceId] > capacityOfResources[resourceId])
-				throw runtime_error("InputReader::readFromStream: Suggested resources are insufficient for activities requirement!");
+		activitiesSuccessors[activityId] = new uint32_t[numberOfSuccessors[activityId]];
+		for (uint32_t k = 0; k < numberOfSuccessors[activityId]; ++k)	{
+			if (successorsOfActivity[k] >= numberOfActivities || successorsOfActivity[k] == activityId)
+				throw invalid_argument("InputReader::readFromArrays: Invalid successor ID of activity "+numberToStr(activityId)+"!");
+			activitiesSuccessors[activityId][k] = successorsOfActivity[k];
 		}
+		successorsOfActivity += numberOfSuccessors[activityId];
 	}
+
+	if (!resourcesSufficient())
+		throw invalid_argument("InputReader::readFromArrays: Suggested resources are insufficient for activities requirement!");
+	if (!precedenceGraphValid())
+		throw invalid_argument("InputReader::readFromArrays: The precedence graph has to be acyclic with the only source (the first activity) and the only sink (the last activity)!");
 }
 
 void InputReader::printInstance(ostream& output)	const	{
@@ -227,12 +259,55 @@ void InputReader::printInstance(ostream& output)	const	{
 
 void InputReader::allocateBaseArrays()	{
 	activitiesDuration = new uint32_t[numberOfActivities];
-	activitiesSuccessors = new uint32_t*[numberOfActivities];
+	activitiesSuccessors = new uint32_t*[numberOfActivities]();
 	activitiesNumberOfSuccessors = new uint32_t[numberOfActivities];
 	capacityOfResources = new uint32_t[totalNumberOfResources];
+	// The requirements are stored in one row-major block.
 	activitiesRequiredResources = new uint32_t*[numberOfActivities];
-	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)
-		activitiesRequiredResources[activityId] = new uint32_t[totalNumberOfResources];
+	activitiesRequiredResources[0] = new uint32_t[numberOfActivities*totalNumberOfResources];
+	for (uint32_t activityId = 1; activityId < numberOfActivities; ++activityId)
+		activitiesRequiredResources[activityId] = activitiesRequiredResources[0]+activityId*totalNumberOfResources;
+}
+
+bool InputReader::resourcesSufficient() const	{
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
+		for (uint32_t resourceId = 0; resourceId < totalNumberOfResources; ++resourceId)	{
+			if (activitiesRequiredResources[activityId][resourceId] > capacityOfResources[resourceId])
+				return false;
+		}
+	}
+	return true;
+}
+
+bool InputReader::precedenceGraphValid() const	{
+	vector<uint32_t> numberOfPredecessors(numberOfActivities, 0);
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
+		for (uint32_t k = 0; k < activitiesNumberOfSuccessors[activityId]; ++k)
+			++numberOfPredecessors[activitiesSuccessors[activityId][k]];
+	}
+
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
+		if ((numberOfPredecessors[activityId] == 0) != (activityId == 0))
+			return false;
+		if ((activitiesNumberOfSuccessors[activityId] == 0) != (activityId+1 == numberOfActivities))
+			return false;
+	}
+
+	// All activities are reached from the only source if and only if the graph has no cycle.
+	uint32_t numberOfSorted = 0;
+	vector<uint32_t> readyActivities(1, 0);
+	while (!readyActivities.empty())	{
+		uint32_t activityId = readyActivities.back();
+		readyActivities.pop_back();
+		++numberOfSorted;
+		for (uint32_t k = 0; k < activitiesNumberOfSuccessors[activityId]; ++k)	{
+			uint32_t successorId = activitiesSuccessors[activityId][k];
+			if (--numberOfPredecessors[successorId] == 0)
+				readyActivities.push_back(successorId);
+		}
+	}
+
+	return (numberOfSorted == numberOfActivities);
 }
 
 uint32_t InputReader::strToNumber(const string& number)	const {
@@ -251,14 +326,18 @@ void InputReader::freeInstanceData()	{
 	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
 		if (activitiesSuccessors != NULL)
 			delete[] activitiesSuccessors[activityId];
-		if (activitiesRequiredResources != NULL)
-			delete[] activitiesRequiredResources[activityId];
 	}
 
+	if (activitiesRequiredResources != NULL && numberOfActivities > 0)
+		delete[] activitiesRequiredResources[0];
+
 	delete[] activitiesSuccessors;	
 	delete[] activitiesRequiredResources;
 	delete[] activitiesDuration;
 	delete[] activitiesNumberOfSuccessors;
 	delete[] capacityOfResources;
+
+	activitiesSuccessors = activitiesRequiredResources = NULL;
+	activitiesDuration = activitiesNumberOfSuccessors = capacityOfResources = NULL;
 }
 
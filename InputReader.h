@@ -49,6 +49,20 @@ class InputReader {
 		 * \brief Project data are read from the input stream.
 		 */
 		void readFromStream(std::istream& IN);
+		/*!
+		 * \param numberOfActivities The number of activities including the dummy start (the first) and end (the last) activity.
+		 * \param numberOfResources The number of renewable resources.
+		 * \param durations The duration of each activity.
+		 * \param capacities The capacity of each resource.
+		 * \param requirements The requirements of the activities, the row-major matrix (number of activities x number of resources).
+		 * \param numberOfSuccessors The number of successors of each activity.
+		 * \param successors The successors of all activities, the successors of the activity i follow the successors of the activity i-1.
+		 * \exception invalid_argument Invalid number of activities or resources, invalid successor, insufficient capacity of a resource
+		 * or invalid precedence graph (a cycle, a source other than the first activity or a sink other than the last activity).
+		 * \brief Project data are copied from the arrays, the ids of the activities and the resources start from zero.
+		 */
+		void readFromArrays(const uint32_t& numberOfActivities, const uint32_t& numberOfResources, const uint32_t * const& durations,
+				const uint32_t * const& capacities, const uint32_t * const& requirements, const uint32_t * const& numberOfSuccessors, const uint32_t * const& successors);
 
 		//! Return number of the activities.
 		uint32_t getNumberOfActivities() const { return numberOfActivities; }
@@ -78,6 +92,13 @@ class InputReader {
 
 		//! Helper function which allocates some arrays.
 		void allocateBaseArrays();
+		//! Return true if the capacities of the resources suffice for the requirements of all activities.
+		bool resourcesSufficient() const;
+		/*!
+		 * \return True if the precedence graph is acyclic, the first activity is its only source and the last activity its only sink.
+		 * \brief The graph is sorted topologically (Kahn's algorithm), the solver relies on these properties of the instance.
+		 */
+		bool precedenceGraphValid() const;
 		/*!
 		 * \param number String number.
 		 * \return Integer number.
@@ -106,7 +127,7 @@ class InputReader {
 		uint32_t totalNumberOfResources;
 		//! Duration of the activities.
 		uint32_t *activitiesDuration;
-		//! Activities resources requirements.
+		//! Activities resources requirements. The rows point to one row-major block.
 		uint32_t **activitiesRequiredResources;
 		//! Activities successors.
 		uint32_t **activitiesSuccessors;
@@ -0,0 +1,143 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include "NumaTopology.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+using namespace std;
+
+//! The node to which the current thread is bound, -1 if the thread is not bound.
+static thread_local int32_t boundNode = -1;
+
+NumaTopology::NumaTopology()	{
+	#ifdef __linux__
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	if (sched_getaffinity(0, sizeof(cpu_set_t), &cpuSet) == 0)	{
+		for (uint32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu)	{
+			if (CPU_ISSET(cpu, &cpuSet))
+				originalCpus.push_back(cpu);
+		}
+	}
+
+	string onlineNodes;
+	ifstream online("/sys/devices/system/node/online");
+	if (online)
+		getline(online, onlineNodes);
+
+	vector<uint32_t> nodes = parseCpuList(onlineNodes);
+	for (vector<uint32_t>::const_iterator it = nodes.begin(); it != nodes.end(); ++it)	{
+		ostringstream path;
+		path<<"/sys/devices/system/node/node"<<*it<<"/cpulist";
+		ifstream in(path.str().c_str());
+		string cpuList;
+		if (in && getline(in, cpuList))	{
+			// Only the processors allowed for the process (e.g. by taskset or cpuset) are used, the nodes without them are skipped.
+			vector<uint32_t> cpus = parseCpuList(cpuList), allowedCpus;
+			for (vector<uint32_t>::const_iterator cit = cpus.begin(); cit != cpus.end(); ++cit)	{
+				if (originalCpus.empty() || binary_search(originalCpus.begin(), originalCpus.end(), *cit))
+					allowedCpus.push_back(*cit);
+			}
+			if (!allowedCpus.empty())	{
+				nodeIds.push_back(*it);
+				cpusOfNodes.push_back(allowedCpus);
+			}
+		}
+	}
+	#endif
+
+	// Unknown topology, one node without binding.
+	if (cpusOfNodes.empty())	{
+		nodeIds.push_back(0);
+		cpusOfNodes.push_back(vector<uint32_t>());
+	}
+}
+
+bool NumaTopology::bindCurrentThread(const uint32_t& node) const	{
+	if (node >= cpusOfNodes.size() || cpusOfNodes[node].empty())
+		return false;
+	if (boundNode == (int32_t) node)
+		return true;
+
+	#ifdef __linux__
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	for (vector<uint32_t>::const_iterator it = cpusOfNodes[node].begin(); it != cpusOfNodes[node].end(); ++it)	{
+		if (*it < CPU_SETSIZE)
+			CPU_SET(*it, &cpuSet);
+	}
+	if (sched_setaffinity(0, sizeof(cpu_set_t), &cpuSet) == 0)	{
+		boundNode = node;
+		return true;
+	}
+	#endif
+
+	return false;
+}
+
+void NumaTopology::unbindCurrentThread() const	{
+	#ifdef __linux__
+	if (boundNode >= 0 && !originalCpus.empty())	{
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		for (vector<uint32_t>::const_iterator it = originalCpus.begin(); it != originalCpus.end(); ++it)
+			CPU_SET(*it, &cpuSet);
+		sched_setaffinity(0, sizeof(cpu_set_t), &cpuSet);
+	}
+	#endif
+	boundNode = -1;
+}
+
+int32_t NumaTopology::getCurrentNode() const	{
+	#ifdef __linux__
+	int cpu = sched_getcpu();
+	for (uint32_t node = 0; cpu >= 0 && node < cpusOfNodes.size(); ++node)	{
+		for (vector<uint32_t>::const_iterator it = cpusOfNodes[node].begin(); it != cpusOfNodes[node].end(); ++it)	{
+			if (*it == (uint32_t) cpu)
+				return node;
+		}
+	}
+	#endif
+	return -1;
+}
+
+vector<uint32_t> NumaTopology::parseCpuList(const string& cpuList)	{
+	vector<uint32_t> cpus;
+	istringstream in(cpuList);
+	string range;
+	while (getline(in, range, ','))	{
+		uint32_t first = 0, last = 0;
+		char dash = 0;
+		istringstream rangeStream(range);
+		if (!(rangeStream>>first))
+			continue;
+		if (rangeStream>>dash>>last && dash == '-')	{
+			for (uint32_t cpu = first; cpu <= last; ++cpu)
+				cpus.push_back(cpu);
+		} else {
+			cpus.push_back(first);
+		}
+	}
+	return cpus;
+}
+
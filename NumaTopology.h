@@ -0,0 +1,79 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef HLIDAC_PES_NUMA_TOPOLOGY_H
+#define HLIDAC_PES_NUMA_TOPOLOGY_H
+
+/*!
+ * \file NumaTopology.h
+ * \author Libor Bukata
+ * \brief Detection of NUMA nodes and binding of threads to them.
+ */
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+/*!
+ * The NUMA nodes and their processors are read from the sysfs (/sys/devices/system/node) and threads are bound
+ * to the processors of a node by sched_setaffinity. If the topology cannot be detected (e.g. non-Linux systems)
+ * then one node is assumed and the binding is ignored.
+ * \class NumaTopology
+ * \brief The NUMA topology of the machine.
+ */
+class NumaTopology {
+	public:
+		/*!
+		 * The affinity of the calling thread is remembered, it is restored by the method unbindCurrentThread.
+		 * The processors of the nodes are restricted to this affinity, the nodes without an allowed processor are omitted.
+		 * \brief Detect the NUMA nodes and their processors.
+		 */
+		NumaTopology();
+
+		//! Return the number of detected NUMA nodes. At least one node is returned.
+		uint32_t getNumberOfNodes() const { return cpusOfNodes.size(); }
+		//! Return the system identification of the node with the given index.
+		uint32_t getNodeId(const uint32_t& node) const { return nodeIds[node]; }
+		/*!
+		 * \param node The index of the NUMA node.
+		 * \return True if the thread was bound else false.
+		 * \brief The calling thread is allowed to run only on the processors of the node. The binding is skipped
+		 * if the thread is already bound to the node.
+		 */
+		bool bindCurrentThread(const uint32_t& node) const;
+		//! The calling thread gets back the affinity of the thread that created the topology.
+		void unbindCurrentThread() const;
+		//! Return the index of the NUMA node of the processor that runs the calling thread or -1 if it cannot be determined.
+		int32_t getCurrentNode() const;
+
+	private:
+
+		/*!
+		 * \param cpuList The list of processors (or nodes) in the sysfs format, e.g. "0-3,8-11".
+		 * \return The items of the list.
+		 */
+		static std::vector<uint32_t> parseCpuList(const std::string& cpuList);
+
+		//! The system identifications of the online NUMA nodes.
+		std::vector<uint32_t> nodeIds;
+		//! The allowed processors of each NUMA node.
+		std::vector<std::vector<uint32_t> > cpusOfNodes;
+		//! The processors allowed for the thread that created the topology.
+		std::vector<uint32_t> originalCpus;
+};
+
+#endif
+
@@ -26,9 +26,21 @@
 #include <sstream>
 #include <stdexcept>
 #include <vector>
+
+#ifdef __GNUC__
+#include <sys/time.h>
+#elif defined _WIN32 || defined _WIN64 || defined WIN32 || defined WIN64
+#include <Windows.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "ConfigureRCPSP.h"
 #include "InputReader.h"
 #include "ScheduleSolver.h"
+#include "RCPSPServer.h"
 
 using namespace std;
 
@@ -47,6 +59,7 @@ int main(int argc, char* argv[])	{
  * \param i Current index at argv two-dimensional array. Can be modified.
  * \param argc Number of arguments (program name + switches + parameters) that were given through command line.
  * \param argv Command line arguments.
+ * \param relativeValue If true then the double parameter has to be from the range 0-1.
  * \tparam T Integer or double.
  * \exception invalid_argument Parameter cannot be read.
  * \exception range_error Invalid value of read parameter.
@@ -54,7 +67,7 @@ int main(int argc, char* argv[])	{
  * \brief Helper function for command line processing.
  */
 template <typename T>
-T optionHelper(const string& option, int& i, const int& argc, char* argv[])	{
+T optionHelper(const string& option, int& i, const int& argc, char* argv[], const bool& relativeValue = true)	{
 	if (i+1 < argc)	{
 		T value = T();
 		string numStr = argv[++i];
@@ -63,7 +76,7 @@ T optionHelper(const string& option, int& i, const int& argc, char* argv[])	{
 			throw invalid_argument("Cannot read parameter! (option \""+option+"\")");
 		if (value < 0 || (!numStr.empty() && numStr[0] == '-'))
 			throw range_error("Parameter value cannot be negative!");
-		if (typeid(value) == typeid(double) && (value < 0 || value > 1))
+		if (typeid(value) == typeid(double) && relativeValue && (value < 0 || value > 1))
 			throw range_error("Invalid range of double! (correct range 0-1)");
 		return value;
 	} else {
@@ -71,6 +84,186 @@ T optionHelper(const string& option, int& i, const int& argc, char* argv[])	{
 	}
 }
 
+/*!
+ * \return The current wall clock time in seconds.
+ * \brief Helper function for measuring the run time of the batch.
+ */
+double getWallClockTime()	{
+	#ifdef __GNUC__
+	timeval currentTime;
+	gettimeofday(&currentTime, NULL);
+	return currentTime.tv_sec+currentTime.tv_usec/1000000.;
+	#elif defined _WIN32 || defined _WIN64 || defined WIN32 || defined WIN64
+	LARGE_INTEGER ticksPerSecond, currentTimeStamp;
+	QueryPerformanceFrequency(&ticksPerSecond);
+	QueryPerformanceCounter(&currentTimeStamp);
+	return currentTimeStamp.QuadPart/((double) ticksPerSecond.QuadPart);
+	#endif
+}
+
+/*!
+ * \param filename The filename of the instance.
+ * \param reader The read instance.
+ * \param config The configuration of the solver.
+ * \param numberOfThreads The number of threads solving the instance. All threads are used if it is zero.
+ * \param verbose If true then the whole schedule is printed.
+ * \param output Output stream to which the results are printed.
+ * \param warmStartFile The file with the order or the schedule from which the search starts. The initial solution is created if it is empty.
+ * \exception exception Invalid configuration of the solver, the warm start file cannot be read or the files cannot be written.
+ * \brief The instance is solved, results are printed and required files are written.
+ */
+void solveInstance(const string& filename, const InputReader& reader, const SolverConfig& config, const uint32_t& numberOfThreads, const bool& verbose, ostream& output, const string& warmStartFile = "")	{
+	// Init schedule solver.
+	ScheduleSolver solver(reader, numberOfThreads, config);
+	if (!warmStartFile.empty())
+		solver.setInitialSolution(warmStartFile);
+	// Solve read instance.
+	string graphFilename = "", resultFilename = "";
+	if (ConfigureRCPSP::WRITE_GRAPH == true || ConfigureRCPSP::WRITE_RESULT_FILE == true)	{
+		int32_t i;
+		for (i = filename.size()-1; i >= 0; --i)	{
+			if (filename[i] == '.')
+				break;
+		}
+		if (i > 0)	{
+			if (ConfigureRCPSP::WRITE_GRAPH == true)
+				graphFilename = string(filename, 0, i) + ".csv";
+			if (ConfigureRCPSP::WRITE_RESULT_FILE == true)
+				resultFilename = string(filename, 0, i) + ".res";
+		}
+	}
+	solver.solveSchedule(ConfigureRCPSP::NUMBER_OF_ITERATIONS, graphFilename, ConfigureRCPSP::TIME_LIMIT);
+	// Print results.
+	if (verbose == true)	{
+		solver.printBestSchedule(true, output);
+	}	else	{
+		output<<filename<<": ";
+		solver.printBestSchedule(false, output);
+	}
+	// Write the best schedule to file.
+	if (!resultFilename.empty())
+		solver.writeBestScheduleToFile(resultFilename);
+}
+
+/*!
+ * \param inputFiles The filenames of the instances.
+ * \param results The printed results of the solved instances.
+ * \param errors The error messages of the failed instances, empty if the instance was solved.
+ * \param solved True if the instance is finished (solved or failed).
+ * \param nextToPrint The index of the first instance that was not printed yet. It is updated.
+ * \param output Output stream to which the results are printed, the errors are printed to the error output.
+ * \brief All finished instances that preserve the input order are printed.
+ */
+void printFinishedResults(const vector<string>& inputFiles, const vector<string>& results, const vector<string>& errors,
+		const vector<bool>& solved, uint32_t& nextToPrint, ostream& output)	{
+	while (nextToPrint < inputFiles.size() && solved[nextToPrint])	{
+		if (errors[nextToPrint].empty())
+			output<<results[nextToPrint]<<flush;
+		else
+			cerr<<inputFiles[nextToPrint]<<": "<<errors[nextToPrint]<<endl;
+		++nextToPrint;
+	}
+}
+
+/*!
+ * Small instances are solved concurrently, each by one thread. Large instances (more activities than
+ * BATCH_LARGE_INSTANCE_THRESHOLD) are solved first, each by a team of BATCH_TEAM_SIZE threads.
+ * Results are printed in the order of the input files as soon as all preceding instances are solved.
+ * \param inputFiles The filenames of the instances.
+ * \param config The configuration of the solvers.
+ * \param output Output stream to which the results are printed.
+ * \return Zero if all instances were solved else the number of failed instances.
+ * \brief Solve all instances concurrently and print the throughput of the batch.
+ */
+uint32_t solveBatch(const vector<string>& inputFiles, const SolverConfig& config, ostream& output)	{
+	double startTime = getWallClockTime();
+	uint32_t numberOfInstances = inputFiles.size();
+
+	// All instances are read at first to find out their sizes.
+	vector<InputReader*> readers(numberOfInstances, NULL);
+	vector<string> results(numberOfInstances), errors(numberOfInstances);
+	vector<bool> solved(numberOfInstances, false);
+	vector<uint32_t> largeInstances, smallInstances;
+
+	#pragma omp parallel for schedule(dynamic)
+	for (uint32_t idx = 0; idx < numberOfInstances; ++idx)	{
+		try {
+			InputReader *reader = new InputReader();
+			readers[idx] = reader;
+			reader->readFromFile(inputFiles[idx]);
+		} catch (exception& e)	{
+			errors[idx] = e.what();
+		}
+	}
+
+	for (uint32_t idx = 0; idx < numberOfInstances; ++idx)	{
+		if (!errors[idx].empty())
+			solved[idx] = true;
+		else if (readers[idx]->getNumberOfActivities() > ConfigureRCPSP::BATCH_LARGE_INSTANCE_THRESHOLD)
+			largeInstances.push_back(idx);
+		else
+			smallInstances.push_back(idx);
+	}
+
+	#ifdef _OPENMP
+	uint32_t numberOfThreads = omp_get_max_threads();
+	#else
+	uint32_t numberOfThreads = 1;
+	#endif
+	uint32_t teamSize = ConfigureRCPSP::BATCH_TEAM_SIZE;
+	if (teamSize == 0 || teamSize > numberOfThreads)
+		teamSize = numberOfThreads;
+	uint32_t numberOfTeams = numberOfThreads/teamSize;
+	#ifdef _OPENMP
+	if (numberOfTeams > 1 && teamSize > 1)
+		omp_set_max_active_levels(max(omp_get_max_active_levels(), 2));
+	#endif
+
+	uint32_t nextToPrint = 0;
+	for (uint32_t phase = 0; phase < 2; ++phase)	{
+		const vector<uint32_t>& queue = (phase == 0 ? largeInstances : smallInstances);
+		uint32_t solverThreads = (phase == 0 ? teamSize : 1);
+		uint32_t workers = (phase == 0 ? numberOfTeams : numberOfThreads);
+
+		#pragma omp parallel for schedule(dynamic,1) num_threads(workers)
+		for (uint32_t q = 0; q < queue.size(); ++q)	{
+			uint32_t idx = queue[q];
+			try {
+				ostringstream result;
+				solveInstance(inputFiles[idx], *readers[idx], config, solverThreads, false, result);
+				results[idx] = result.str();
+			} catch (exception& e)	{
+				errors[idx] = e.what();
+			}
+
+			delete readers[idx];
+			readers[idx] = NULL;
+
+			#pragma omp critical
+			{
+				solved[idx] = true;
+				printFinishedResults(inputFiles, results, errors, solved, nextToPrint, output);
+			}
+		}
+	}
+
+	// The unreadable instances that follow the last solved instance were not printed yet.
+	printFinishedResults(inputFiles, results, errors, solved, nextToPrint, output);
+
+	uint32_t numberOfFailed = 0;
+	for (uint32_t idx = 0; idx < numberOfInstances; ++idx)	{
+		if (!errors[idx].empty())
+			++numberOfFailed;
+		delete readers[idx];
+	}
+
+	double batchTime = getWallClockTime()-startTime;
+	output<<"Batch throughput: "<<(batchTime > 0 ? 3600.*(numberOfInstances-numberOfFailed)/batchTime : 0.)<<" instances/hour";
+	output<<" ("<<numberOfInstances-numberOfFailed<<" instances solved in "<<batchTime<<" s)"<<endl;
+
+	return numberOfFailed;
+}
+
 /*!
  * Entry point for RCPSP solver. Command line arguments are processed, input instances are
  * read and solved. Results are printed to console (can be easily redirected to file).
@@ -83,6 +276,8 @@ T optionHelper(const string& option, int& i, const int& argc, char* argv[])	{
 int rcpsp(int argc, char* argv[])	{
 
 	vector<string> inputFiles;
+	string warmStartFile;
+	string serverSocketPath;
 
 	for (int i = 1; i < argc; ++i)	{
 
@@ -99,6 +294,24 @@ int rcpsp(int argc, char* argv[])	{
 			}
 		}
 
+		if (arg == "--warm-start" || arg == "-ws")	{
+			if (i+1 < argc)	{
+				warmStartFile = argv[++i];
+			} else {
+				cerr<<"Option \"--warm-start\" require parameter!"<<endl;
+				return 1;
+			}
+		}
+
+		if (arg == "--server" || arg == "-srv")	{
+			if (i+1 < argc)	{
+				serverSocketPath = argv[++i];
+			} else {
+				cerr<<"Option \"--server\" require parameter!"<<endl;
+				return 1;
+			}
+		}
+
 		if (arg == "--simple-tabu-list" || arg == "-stl")
 			ConfigureRCPSP::TABU_LIST_TYPE = SIMPLE_TABU;
 
@@ -111,11 +324,45 @@ int rcpsp(int argc, char* argv[])	{
 		if (arg == "--write-result-file" || arg == "-wrf")
 			ConfigureRCPSP::WRITE_RESULT_FILE = true;
 
+		if (arg == "--speculative-evaluation" || arg == "-se")
+			ConfigureRCPSP::SPECULATIVE_EVALUATION = true;
+
+		if (arg == "--lower-bound-filter" || arg == "-lbf")
+			ConfigureRCPSP::LOWER_BOUND_FILTER = true;
+
+		if (arg == "--parallel-sgs" || arg == "-psgs")
+			ConfigureRCPSP::SCHEDULE_GENERATION_SCHEME = PARALLEL_SGS;
+
+		if (arg == "--mixed-sgs" || arg == "-msgs")
+			ConfigureRCPSP::SCHEDULE_GENERATION_SCHEME = MIXED_SGS;
+
+		if (arg == "--critical-neighbourhood" || arg == "-cn")
+			ConfigureRCPSP::CRITICAL_NEIGHBOURHOOD = true;
+
+		if (arg == "--renumber-activities" || arg == "-ra")
+			ConfigureRCPSP::RENUMBER_ACTIVITIES = true;
+
+		if (arg == "--asynchronous-search" || arg == "-as")
+			ConfigureRCPSP::ASYNCHRONOUS_SEARCH = true;
+
+		if (arg == "--portfolio-mode" || arg == "-pm")
+			ConfigureRCPSP::PORTFOLIO_MODE = true;
+
+		if (arg == "--numa-aware" || arg == "-na")
+			ConfigureRCPSP::NUMA_AWARE = true;
+
+		if (arg == "--batch-mode" || arg == "-bm")
+			ConfigureRCPSP::BATCH_MODE = true;
+
 		try {
 			if (arg == "--number-of-iterations" || arg == "-noi")
 				ConfigureRCPSP::NUMBER_OF_ITERATIONS = optionHelper<uint32_t>("--number-of-iterations", i, argc, argv);
 			if (arg == "--max-iter-since-best" || arg == "-misb")
 				ConfigureRCPSP::MAXIMAL_NUMBER_OF_ITERATIONS_SINCE_BEST = optionHelper<uint32_t>("--max-iter-since-best", i, argc, argv);
+			if (arg == "--cycle-detection-history" || arg == "-cdh")
+				ConfigureRCPSP::CYCLE_DETECTION_HISTORY = optionHelper<uint32_t>("--cycle-detection-history", i, argc, argv);
+			if (arg == "--priority-rule-passes" || arg == "-prp")
+				ConfigureRCPSP::PRIORITY_RULE_PASSES = optionHelper<uint32_t>("--priority-rule-passes", i, argc, argv);
 			if (arg == "--tabu-list-size" || arg == "-tls")
 				ConfigureRCPSP::SIMPLE_TABU_LIST_SIZE = optionHelper<uint32_t>("--tabu-list-size", i, argc, argv);
 			if (arg == "--randomize-erase-amount" || arg == "-rea")
@@ -130,6 +377,28 @@ int rcpsp(int argc, char* argv[])	{
 				ConfigureRCPSP::SHIFT_RANGE = optionHelper<uint32_t>("--shift-range", i, argc, argv);
 			if (arg == "--diversification-swaps" || arg == "-ds")
 				ConfigureRCPSP::DIVERSIFICATION_SWAPS = optionHelper<uint32_t>("--diversification-swaps", i, argc, argv);
+			if (arg == "--neighbourhood-sample-percentage" || arg == "-nsp")
+				ConfigureRCPSP::NEIGHBOURHOOD_SAMPLE_PERCENTAGE = optionHelper<uint32_t>("--neighbourhood-sample-percentage", i, argc, argv);
+			if (arg == "--full-scan-interval" || arg == "-fsi")
+				ConfigureRCPSP::CRITICAL_NEIGHBOURHOOD_FULL_SCAN_INTERVAL = optionHelper<uint32_t>("--full-scan-interval", i, argc, argv);
+			if (arg == "--evaluation-cache-size" || arg == "-ecs")
+				ConfigureRCPSP::EVALUATION_CACHE_SIZE = optionHelper<uint32_t>("--evaluation-cache-size", i, argc, argv);
+			if (arg == "--random-seed" || arg == "-rs")
+				ConfigureRCPSP::RANDOM_SEED = optionHelper<uint32_t>("--random-seed", i, argc, argv);
+			if (arg == "--time-limit" || arg == "-tl")
+				ConfigureRCPSP::TIME_LIMIT = optionHelper<double>("--time-limit", i, argc, argv, false);
+			if (arg == "--number-of-islands" || arg == "-nois")
+				ConfigureRCPSP::NUMBER_OF_ISLANDS = optionHelper<uint32_t>("--number-of-islands", i, argc, argv);
+			if (arg == "--threads-per-island" || arg == "-tpi")
+				ConfigureRCPSP::THREADS_PER_ISLAND = optionHelper<uint32_t>("--threads-per-island", i, argc, argv);
+			if (arg == "--island-exchange-interval" || arg == "-iei")
+				ConfigureRCPSP::ISLAND_EXCHANGE_INTERVAL = optionHelper<uint32_t>("--island-exchange-interval", i, argc, argv);
+			if (arg == "--large-instance-threshold" || arg == "-lit")
+				ConfigureRCPSP::BATCH_LARGE_INSTANCE_THRESHOLD = optionHelper<uint32_t>("--large-instance-threshold", i, argc, argv);
+			if (arg == "--batch-team-size" || arg == "-bts")
+				ConfigureRCPSP::BATCH_TEAM_SIZE = optionHelper<uint32_t>("--batch-team-size", i, argc, argv);
+			if (arg == "--server-workers" || arg == "-sw")
+				ConfigureRCPSP::SERVER_WORKERS = optionHelper<uint32_t>("--server-workers", i, argc, argv);
 		} catch (exception& e)	{
 			cerr<<e.what()<<endl;
 			return 1;
@@ -144,14 +413,26 @@ int rcpsp(int argc, char* argv[])	{
 			cout<<"Options:"<<endl;
 			cout<<"\t"<<"--input-files ARG, -if ARG, ARG=\"FILE1 FILE2 ... FILEX\""<<endl;
 			cout<<"\t\t"<<"Instances data. Input files are delimited by space."<<endl;
+			cout<<"\t"<<"--warm-start ARG, -ws ARG, ARG=FILE"<<endl;
+			cout<<"\t\t"<<"The search starts from the order of activities in the text file (ids delimited by white spaces)"<<endl;
+			cout<<"\t\t"<<"or from the schedule of the .res file. The precedence violations are repaired. Ignored in the batch mode."<<endl;
 			cout<<"\t"<<"--simple-tabu-list, -stl"<<endl;
 			cout<<"\t\t"<<"The simple version of the tabu list is used."<<endl;
 			cout<<"\t"<<"--advanced-tabu-list, -atl"<<endl;
 			cout<<"\t\t"<<"More sophisticated version of the tabu list is used."<<endl;
 			cout<<"\t"<<"--number-of-iterations ARG, -noi ARG, ARG=POSITIVE_INTEGER"<<endl;
 			cout<<"\t\t"<<"Number of iterations after which the search process will be stopped."<<endl;
+			cout<<"\t"<<"--time-limit ARG, -tl ARG, ARG=POSITIVE_DOUBLE"<<endl;
+			cout<<"\t\t"<<"Wall clock time limit (seconds) after which the best found schedule is returned. Zero means no limit."<<endl;
+			cout<<"\t\t"<<"In the batch mode the limit applies to each instance."<<endl;
 			cout<<"\t"<<"--max-iter-since-best ARG, -misb ARG, ARG=POSITIVE_INTEGER"<<endl;
 			cout<<"\t\t"<<"Maximal number of iterations without improving solution after which diversification is called."<<endl;
+			cout<<"\t"<<"--cycle-detection-history ARG, -cdh ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Number of recently visited orders that are remembered to detect a cycle of the search."<<endl;
+			cout<<"\t\t"<<"The first cycle prunes the tabu list, the next one calls the diversification. Zero disables the detection."<<endl;
+			cout<<"\t"<<"--priority-rule-passes ARG, -prp ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Number of passes of the priority rule heuristic that creates the initial order. The LFT, LST, MTS and GRPW rules"<<endl;
+			cout<<"\t\t"<<"are applied first, the other passes sample the rules with the regret-biased probabilities. Zero keeps the level order."<<endl;
 			cout<<"\t"<<"--tabu-list-size ARG, -tls ARG, ARG=POSITIVE_INTEGER"<<endl;
 			cout<<"\t\t"<<"Size of the simple tabu list. Ignored for the advanced tabu list."<<endl;
 			cout<<"\t"<<"--randomize-erase-amount ARG, -rea ARG, ARG=POSITIVE_DOUBLE"<<endl;
@@ -166,12 +447,67 @@ int rcpsp(int argc, char* argv[])	{
 			cout<<"\t\t"<<"Maximal number of activities which moved activity can go through."<<endl;
 			cout<<"\t"<<"--diversification-swaps ARG, -ds ARG, ARG=POSITIVE_INTEGER"<<endl;
 			cout<<"\t\t"<<"Number of performed swaps for every diversification."<<endl;
+			cout<<"\t"<<"--speculative-evaluation, -se"<<endl;
+			cout<<"\t\t"<<"Threads that finished their part of the neighbourhood evaluate the neighbourhood of the best candidate move."<<endl;
+			cout<<"\t\t"<<"The results are reused in the next iteration if the candidate move is applied."<<endl;
+			cout<<"\t"<<"--lower-bound-filter, -lbf"<<endl;
+			cout<<"\t\t"<<"The moves whose lower bound of the cost cannot beat the best move of the thread or the aspiration level are not evaluated."<<endl;
+			cout<<"\t\t"<<"The bound is computed from the schedule of the current order and the longest paths to the end activity."<<endl;
+			cout<<"\t"<<"--parallel-sgs, -psgs"<<endl;
+			cout<<"\t\t"<<"The orders of the neighbourhood are decoded by the parallel (time incrementing, non-delay) schedule generation scheme."<<endl;
+			cout<<"\t\t"<<"The activities are prioritized by their positions in the order. The serial scheme is used by default."<<endl;
+			cout<<"\t"<<"--mixed-sgs, -msgs"<<endl;
+			cout<<"\t\t"<<"Each order of the neighbourhood is decoded by both schemes and the shorter schedule is taken."<<endl;
+			cout<<"\t"<<"--critical-neighbourhood, -cn"<<endl;
+			cout<<"\t\t"<<"Only the moves of the activities on the critical chains (precedence or resource links) of the current schedule are evaluated."<<endl;
+			cout<<"\t"<<"--full-scan-interval ARG, -fsi ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Every ARG-th iteration evaluates the full neighbourhood if the critical neighbourhood is enabled."<<endl;
+			cout<<"\t"<<"--neighbourhood-sample-percentage ARG, -nsp ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Percentage (1-100) of the neighbourhood rows (moved activities) that are randomly selected and evaluated in each iteration."<<endl;
+			cout<<"\t"<<"--evaluation-cache-size ARG, -ecs ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Maximal number of entries of the cache that maps the hashes of the evaluated orders to their costs."<<endl;
+			cout<<"\t\t"<<"The evaluation of a repeatedly visited order is skipped. The cache is smaller if the iterations cannot fill it. Zero disables the cache."<<endl;
+			cout<<"\t"<<"--renumber-activities, -ra"<<endl;
+			cout<<"\t\t"<<"Activities are internally relabelled in the level order of the precedence graph to improve the memory locality."<<endl;
+			cout<<"\t\t"<<"The results are printed and written with the original ids."<<endl;
+			cout<<"\t"<<"--random-seed ARG, -rs ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"The seed of the random number generators of the search. The search with one thread is reproducible"<<endl;
+			cout<<"\t\t"<<"for the same seed (without the time limit). If zero then the seed is derived from the current time."<<endl;
+			cout<<"\t"<<"--number-of-islands ARG, -nois ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Number of independent search trajectories (islands) that are searched concurrently."<<endl;
+			cout<<"\t"<<"--threads-per-island ARG, -tpi ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Number of threads that evaluate the neighbourhood of one island."<<endl;
+			cout<<"\t\t"<<"If zero then available threads are divided equally among islands."<<endl;
+			cout<<"\t"<<"--island-exchange-interval ARG, -iei ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Number of iterations after which the islands exchange their best orders through the elite pool."<<endl;
+			cout<<"\t"<<"--asynchronous-search, -as"<<endl;
+			cout<<"\t\t"<<"The islands run as asynchronous walkers without barriers. Each walker exchanges the orders with the elite pool"<<endl;
+			cout<<"\t\t"<<"on its own after every island exchange interval. If only one island is set then each thread is a walker."<<endl;
+			cout<<"\t"<<"--portfolio-mode, -pm"<<endl;
+			cout<<"\t\t"<<"The islands alternate the simple and the advanced tabu list and use different swap ranges and tabu list sizes"<<endl;
+			cout<<"\t\t"<<"derived from the set values. If only one island is set then each thread (at least two) is a portfolio member."<<endl;
+			cout<<"\t"<<"--numa-aware, -na"<<endl;
+			cout<<"\t\t"<<"The islands are distributed among NUMA nodes, their threads are bound to the processors of the node"<<endl;
+			cout<<"\t\t"<<"and each node has its own replica of the instance data. Ignored if only one island is used."<<endl;
 			cout<<"\t"<<"--write-makespan-graph, -wmg"<<endl;
 			cout<<"\t\t"<<"If you want to write makespan criterion graph (independent variable is number of iterations)"<<endl;
 			cout<<"\t\t"<<"then use this switch to enable csv file generation."<<endl;
 			cout<<"\t"<<"--write-result-file, -wrf"<<endl;
 			cout<<"\t\t"<<"Add this option if you want to write a file with the best schedule."<<endl;
-			cout<<"\t\t"<<"This file is binary."<<endl<<endl;
+			cout<<"\t\t"<<"This file is binary."<<endl;
+			cout<<"\t"<<"--batch-mode, -bm"<<endl;
+			cout<<"\t\t"<<"Input instances are solved concurrently. Results are printed in the order of the input files"<<endl;
+			cout<<"\t\t"<<"and the throughput of the batch is reported."<<endl;
+			cout<<"\t"<<"--large-instance-threshold ARG, -lit ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Instances with more activities are solved by a team of threads in the batch mode, smaller ones by one thread."<<endl;
+			cout<<"\t"<<"--batch-team-size ARG, -bts ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Number of threads solving one large instance in the batch mode. If zero then all threads are used."<<endl;
+			cout<<"\t"<<"--server ARG, -srv ARG, ARG=SOCKET_PATH"<<endl;
+			cout<<"\t\t"<<"The program runs as a daemon that solves the instances sent through the Unix socket (see RCPSPServer.h"<<endl;
+			cout<<"\t\t"<<"for the protocol). The input files are ignored, the daemon is stopped by SIGINT or SIGTERM."<<endl;
+			cout<<"\t"<<"--server-workers ARG, -sw ARG, ARG=POSITIVE_INTEGER"<<endl;
+			cout<<"\t\t"<<"Number of instances solved concurrently by the server, the threads are divided among them."<<endl;
+			cout<<"\t\t"<<"If zero then each thread solves one instance."<<endl<<endl;
 			cout<<"Default values can be modified at \"DefaultConfigureRCPSP.h\" file."<<endl;
 			return 0;
 		}
@@ -179,40 +515,26 @@ int rcpsp(int argc, char* argv[])	{
 
 	try {
 		bool verbose = (inputFiles.size() == 1 ? true : false);
-		for (vector<string>::const_iterator it = inputFiles.begin(); it != inputFiles.end(); ++it)	{
-			// Filename of instance.
-			string filename = *it;
-			InputReader reader;
-			// Read instance data.
-			reader.readFromFile(filename);
-			// Init schedule solver.
-			ScheduleSolver solver(reader);
-			// Solve read instance.
-			string graphFilename = "", resultFilename = "";
-			if (ConfigureRCPSP::WRITE_GRAPH == true || ConfigureRCPSP::WRITE_RESULT_FILE == true)	{
-				int32_t i;
-				for (i = filename.size()-1; i >= 0; --i)	{
-					if (filename[i] == '.')
-						break;
-				}
-				if (i > 0)	{
-					if (ConfigureRCPSP::WRITE_GRAPH == true)
-						graphFilename = string(filename, 0, i) + ".csv";
-					if (ConfigureRCPSP::WRITE_RESULT_FILE == true)
-						resultFilename = string(filename, 0, i) + ".res";
-				}
-			}
-			solver.solveSchedule(ConfigureRCPSP::NUMBER_OF_ITERATIONS, graphFilename);
-			// Print results.
-			if (verbose == true)	{
-				solver.printBestSchedule();
-			}	else	{
-				cout<<filename<<": ";
-				solver.printBestSchedule(false);
+		// The solvers are configured by the values of the command line switches.
+		SolverConfig config = ConfigureRCPSP::currentSolverConfig();
+		if (!serverSocketPath.empty())	{
+			RCPSPServer server(serverSocketPath, config, ConfigureRCPSP::SERVER_WORKERS, ConfigureRCPSP::NUMBER_OF_ITERATIONS, ConfigureRCPSP::TIME_LIMIT);
+			server.run();
+			return 0;
+		}
+		if (ConfigureRCPSP::BATCH_MODE == true && verbose == false)	{
+			if (solveBatch(inputFiles, config, cout) > 0)
+				return 2;
+		} else {
+			for (vector<string>::const_iterator it = inputFiles.begin(); it != inputFiles.end(); ++it)	{
+				// Filename of instance.
+				string filename = *it;
+				InputReader reader;
+				// Read instance data.
+				reader.readFromFile(filename);
+				// Solve the instance and print results.
+				solveInstance(filename, reader, config, 0, verbose, cout, warmStartFile);
 			}
-			// Write the best schedule to file.
-			if (!resultFilename.empty())
-				solver.writeBestScheduleToFile(resultFilename);
 		}
 	} catch (exception& e)	{
 		cerr<<e.what()<<endl;
@@ -0,0 +1,275 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+/*!
+ * \file RCPSPLibrary.cpp
+ * \author Libor Bukata
+ * \brief The implementation of the C interface of the librcpsp library.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "ConfigureRCPSP.h"
+#include "InputReader.h"
+#include "ScheduleSolver.h"
+#include "RCPSPLibrary.h"
+
+using namespace std;
+
+//! The types of the values of the options.
+enum OptionType {
+	UNSIGNED_OPTION, RELATIVE_OPTION, BOOLEAN_OPTION, TABU_LIST_OPTION, SCHEDULE_GENERATION_SCHEME_OPTION
+};
+
+/*!
+ * \struct LibraryOption
+ * \brief The named option of the library and the member of SolverConfig that is set by the option.
+ */
+struct LibraryOption {
+	//! The name of the option.
+	const char *name;
+	//! The type of the member.
+	OptionType type;
+	//! The offset of the member in SolverConfig.
+	size_t offset;
+};
+
+//! The options that can be set by rcpsp_set_option.
+static const LibraryOption libraryOptions[] = {
+	{ "advanced-tabu-list", TABU_LIST_OPTION, offsetof(SolverConfig, tabuListType) },
+	{ "tabu-list-size", UNSIGNED_OPTION, offsetof(SolverConfig, simpleTabuListSize) },
+	{ "randomize-erase-amount", RELATIVE_OPTION, offsetof(SolverConfig, advancedTabuRandomizeEraseAmount) },
+	{ "swap-life-factor", UNSIGNED_OPTION, offsetof(SolverConfig, advancedTabuSwapLife) },
+	{ "shift-life-factor", UNSIGNED_OPTION, offsetof(SolverConfig, advancedTabuShiftLife) },
+	{ "max-iter-since-best", UNSIGNED_OPTION, offsetof(SolverConfig, maximalNumberOfIterationsSinceBest) },
+	{ "cycle-detection-history", UNSIGNED_OPTION, offsetof(SolverConfig, cycleDetectionHistory) },
+	{ "priority-rule-passes", UNSIGNED_OPTION, offsetof(SolverConfig, priorityRulePasses) },
+	{ "swap-range", UNSIGNED_OPTION, offsetof(SolverConfig, swapRange) },
+	{ "shift-range", UNSIGNED_OPTION, offsetof(SolverConfig, shiftRange) },
+	{ "diversification-swaps", UNSIGNED_OPTION, offsetof(SolverConfig, diversificationSwaps) },
+	{ "speculative-evaluation", BOOLEAN_OPTION, offsetof(SolverConfig, speculativeEvaluation) },
+	{ "lower-bound-filter", BOOLEAN_OPTION, offsetof(SolverConfig, lowerBoundFilter) },
+	{ "schedule-generation-scheme", SCHEDULE_GENERATION_SCHEME_OPTION, offsetof(SolverConfig, scheduleGenerationScheme) },
+	{ "critical-neighbourhood", BOOLEAN_OPTION, offsetof(SolverConfig, criticalNeighbourhood) },
+	{ "full-scan-interval", UNSIGNED_OPTION, offsetof(SolverConfig, criticalNeighbourhoodFullScanInterval) },
+	{ "neighbourhood-sample-percentage", UNSIGNED_OPTION, offsetof(SolverConfig, neighbourhoodSamplePercentage) },
+	{ "evaluation-cache-size", UNSIGNED_OPTION, offsetof(SolverConfig, evaluationCacheSize) },
+	{ "renumber-activities", BOOLEAN_OPTION, offsetof(SolverConfig, renumberActivities) },
+	{ "random-seed", UNSIGNED_OPTION, offsetof(SolverConfig, randomSeed) },
+	{ "number-of-islands", UNSIGNED_OPTION, offsetof(SolverConfig, numberOfIslands) },
+	{ "threads-per-island", UNSIGNED_OPTION, offsetof(SolverConfig, threadsPerIsland) },
+	{ "island-exchange-interval", UNSIGNED_OPTION, offsetof(SolverConfig, islandExchangeInterval) },
+	{ "asynchronous-search", BOOLEAN_OPTION, offsetof(SolverConfig, asynchronousSearch) },
+	{ "portfolio-mode", BOOLEAN_OPTION, offsetof(SolverConfig, portfolioMode) },
+	{ "numa-aware", BOOLEAN_OPTION, offsetof(SolverConfig, numaAware) }
+};
+
+//! The number of the options of the library.
+static const uint32_t numberOfLibraryOptions = sizeof(libraryOptions)/sizeof(LibraryOption);
+
+//! The maximal length of the error message including the terminating zero.
+#define MAX_ERROR_MESSAGE_LENGTH 512
+
+//! The description of the last error of the thread.
+static __thread char lastErrorMessage[MAX_ERROR_MESSAGE_LENGTH] = "";
+
+/*!
+ * \struct rcpsp_solver
+ * \brief The data of the handle, see RCPSPLibrary.h.
+ */
+struct rcpsp_solver {
+	//! The instance copied from the arrays.
+	InputReader reader;
+	//! The number of threads of the solver.
+	uint32_t numberOfThreads;
+	//! The configuration of the solver, it is modified by the options.
+	SolverConfig config;
+	//! The solver, it is created by the first solve.
+	ScheduleSolver *solver;
+};
+
+/*!
+ * \param status The returned status code.
+ * \param message The description of the error.
+ * \return The status code.
+ * \brief The error message of the calling thread is set.
+ */
+static int reportError(const int& status, const char *message)	{
+	strncpy(lastErrorMessage, message, MAX_ERROR_MESSAGE_LENGTH-1);
+	lastErrorMessage[MAX_ERROR_MESSAGE_LENGTH-1] = '\0';
+	return status;
+}
+
+//! Return the option with the given name or NULL if the option does not exist.
+static const LibraryOption* findOption(const char *name)	{
+	for (uint32_t i = 0; i < numberOfLibraryOptions; ++i)	{
+		if (strcmp(libraryOptions[i].name, name) == 0)
+			return &libraryOptions[i];
+	}
+	return NULL;
+}
+
+//! Return true if the value is valid for the option.
+static bool validOptionValue(const LibraryOption& option, const double& value)	{
+	switch (option.type)	{
+		case UNSIGNED_OPTION:
+			return (value >= 0 && value <= numeric_limits<uint32_t>::max() && floor(value) == value);
+		case RELATIVE_OPTION:
+			return (value >= 0 && value <= 1);
+		case SCHEDULE_GENERATION_SCHEME_OPTION:
+			return (value == SERIAL_SGS || value == PARALLEL_SGS || value == MIXED_SGS);
+		default:
+			return true;
+	}
+}
+
+//! The member of the configuration that belongs to the option is set to the value.
+static void writeOption(SolverConfig& config, const LibraryOption& option, const double& value)	{
+	char *member = ((char*) &config)+option.offset;
+	switch (option.type)	{
+		case UNSIGNED_OPTION:
+			*((uint32_t*) member) = (uint32_t) value;
+			break;
+		case RELATIVE_OPTION:
+			*((double*) member) = value;
+			break;
+		case BOOLEAN_OPTION:
+			*((bool*) member) = (value != 0);
+			break;
+		case TABU_LIST_OPTION:
+			*((TabuType*) member) = (value != 0 ? ADVANCED_TABU : SIMPLE_TABU);
+			break;
+		default:
+			*((ScheduleGenerationScheme*) member) = (ScheduleGenerationScheme) value;
+	}
+}
+
+int rcpsp_create(uint32_t numberOfActivities, uint32_t numberOfResources, const uint32_t *durations, const uint32_t *capacities,
+		const uint32_t *requirements, const uint32_t *numberOfSuccessors, const uint32_t *successors, uint32_t numberOfThreads, rcpsp_solver **solver)	{
+	if (solver == NULL || durations == NULL || capacities == NULL || requirements == NULL || numberOfSuccessors == NULL)
+		return reportError(RCPSP_INVALID_ARGUMENT, "rcpsp_create: Invalid NULL argument!");
+
+	uint64_t totalNumberOfSuccessors = 0;
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)
+		totalNumberOfSuccessors += numberOfSuccessors[activityId];
+	if (totalNumberOfSuccessors > 0 && successors == NULL)
+		return reportError(RCPSP_INVALID_ARGUMENT, "rcpsp_create: Invalid NULL argument!");
+
+	rcpsp_solver *handle = NULL;
+	try {
+		handle = new rcpsp_solver;
+		handle->numberOfThreads = numberOfThreads;
+		handle->solver = NULL;
+		handle->reader.readFromArrays(numberOfActivities, numberOfResources, durations, capacities, requirements, numberOfSuccessors, successors);
+	} catch (invalid_argument& e)	{
+		delete handle;
+		return reportError(RCPSP_INVALID_ARGUMENT, e.what());
+	} catch (exception& e)	{
+		delete handle;
+		return reportError(RCPSP_ERROR, e.what());
+	}
+
+	*solver = handle;
+	return RCPSP_OK;
+}
+
+int rcpsp_set_option(rcpsp_solver *solver, const char *name, double value)	{
+	if (solver == NULL || name == NULL)
+		return reportError(RCPSP_INVALID_ARGUMENT, "rcpsp_set_option: Invalid NULL argument!");
+	if (solver->solver != NULL)
+		return reportError(RCPSP_INVALID_ARGUMENT, "rcpsp_set_option: The options cannot be changed after the first solve!");
+
+	const LibraryOption *option = findOption(name);
+	if (option == NULL)
+		return reportError(RCPSP_INVALID_ARGUMENT, (string("rcpsp_set_option: Unknown option \"")+name+"\"!").c_str());
+	if (!validOptionValue(*option, value))
+		return reportError(RCPSP_INVALID_ARGUMENT, (string("rcpsp_set_option: Invalid value of the option \"")+name+"\"!").c_str());
+
+	writeOption(solver->config, *option, value);
+	return RCPSP_OK;
+}
+
+int rcpsp_solve(rcpsp_solver *solver, uint32_t maxIterations, double timeLimit)	{
+	if (solver == NULL)
+		return reportError(RCPSP_INVALID_ARGUMENT, "rcpsp_solve: Invalid NULL argument!");
+	if (!(timeLimit >= 0))
+		return reportError(RCPSP_INVALID_ARGUMENT, "rcpsp_solve: The time limit cannot be negative!");
+
+	try {
+		if (solver->solver == NULL)
+			solver->solver = new ScheduleSolver(solver->reader, solver->numberOfThreads, solver->config);
+		solver->solver->solveSchedule(maxIterations, "", timeLimit);
+	} catch (invalid_argument& e)	{
+		return reportError(RCPSP_INVALID_ARGUMENT, e.what());
+	} catch (exception& e)	{
+		return reportError(RCPSP_ERROR, e.what());
+	}
+
+	return RCPSP_OK;
+}
+
+int rcpsp_get_makespan(const rcpsp_solver *solver, uint32_t *makespan)	{
+	if (solver == NULL || makespan == NULL)
+		return reportError(RCPSP_INVALID_ARGUMENT, "rcpsp_get_makespan: Invalid NULL argument!");
+	if (solver->solver == NULL)
+		return reportError(RCPSP_NOT_SOLVED, "rcpsp_get_makespan: The instance was not solved yet!");
+
+	try {
+		vector<uint32_t> startTimes;
+		*makespan = solver->solver->getBestSchedule(startTimes);
+	} catch (exception& e)	{
+		return reportError(RCPSP_ERROR, e.what());
+	}
+
+	return RCPSP_OK;
+}
+
+int rcpsp_get_start_times(const rcpsp_solver *solver, uint32_t *startTimes)	{
+	if (solver == NULL || startTimes == NULL)
+		return reportError(RCPSP_INVALID_ARGUMENT, "rcpsp_get_start_times: Invalid NULL argument!");
+	if (solver->solver == NULL)
+		return reportError(RCPSP_NOT_SOLVED, "rcpsp_get_start_times: The instance was not solved yet!");
+
+	try {
+		vector<uint32_t> bestStartTimes;
+		solver->solver->getBestSchedule(bestStartTimes);
+		copy(bestStartTimes.begin(), bestStartTimes.end(), startTimes);
+	} catch (exception& e)	{
+		return reportError(RCPSP_ERROR, e.what());
+	}
+
+	return RCPSP_OK;
+}
+
+void rcpsp_destroy(rcpsp_solver *solver)	{
+	if (solver != NULL)	{
+		delete solver->solver;
+		delete solver;
+	}
+}
+
+const char* rcpsp_error_message(void)	{
+	return lastErrorMessage;
+}
+
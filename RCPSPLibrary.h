@@ -0,0 +1,127 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef HLIDAC_PES_RCPSP_LIBRARY_H
+#define HLIDAC_PES_RCPSP_LIBRARY_H
+
+/*!
+ * \file RCPSPLibrary.h
+ * \author Libor Bukata
+ * \brief The C interface of the librcpsp library.
+ *
+ * The interface embeds the solver into other programs (C, C++ or any language with the C foreign function interface).
+ * The instance is created from the arrays in memory, the solver is configured by the named options, the search runs with
+ * the given budget and the best found start times are read back. No exception crosses the interface, each function
+ * returns a status code and the description of the last error of the calling thread is returned by rcpsp_error_message.
+ * Different handles can be used by different threads, one handle must not be used by more threads at once.
+ * The static library requires the C++ standard library and OpenMP at the link time, e.g. "-lrcpsp -lstdc++ -fopenmp".
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * The handle owns the instance, the options and the solver. The solver is created by the first rcpsp_solve call.
+ * \struct rcpsp_solver
+ * \brief The opaque handle of a solver.
+ */
+typedef struct rcpsp_solver rcpsp_solver;
+
+/*!
+ * \enum rcpsp_status
+ * \brief The status codes returned by the functions of the library.
+ */
+enum rcpsp_status {
+	/*! The function succeeded. */
+	RCPSP_OK = 0,
+	/*! An invalid argument, e.g. NULL pointer, unknown option or invalid instance. */
+	RCPSP_INVALID_ARGUMENT = 1,
+	/*! The requested data are not available yet, e.g. the start times before the first rcpsp_solve call. */
+	RCPSP_NOT_SOLVED = 2,
+	/*! Unexpected failure of the solver, e.g. lack of memory. */
+	RCPSP_ERROR = 3
+};
+
+/*!
+ * \param numberOfActivities The number of activities including the dummy start (the first) and end (the last) activity.
+ * \param numberOfResources The number of renewable resources.
+ * \param durations The duration of each activity.
+ * \param capacities The capacity of each resource.
+ * \param requirements The requirements of the activities, the row-major matrix (number of activities x number of resources).
+ * \param numberOfSuccessors The number of successors of each activity.
+ * \param successors The successors of all activities, the successors of the activity i follow the successors of the activity i-1.
+ * \param numberOfThreads The number of threads of the solver. All threads are used if it is zero.
+ * \param solver The created handle is written here, it has to be freed by rcpsp_destroy.
+ * \return RCPSP_OK or RCPSP_INVALID_ARGUMENT if the instance is invalid, e.g. the precedence graph has a cycle or an activity
+ * other than the first one (the last one) has no predecessor (successor).
+ * \brief The instance is copied from the arrays, the ids of the activities and the resources start from zero.
+ */
+int rcpsp_create(uint32_t numberOfActivities, uint32_t numberOfResources, const uint32_t *durations, const uint32_t *capacities,
+		const uint32_t *requirements, const uint32_t *numberOfSuccessors, const uint32_t *successors, uint32_t numberOfThreads, rcpsp_solver **solver);
+
+/*!
+ * \param solver The handle of the solver.
+ * \param name The name of the option, i.e. the long command line switch of RCPSPCpu without the leading dashes,
+ * e.g. "tabu-list-size", "swap-range" or "number-of-islands". The switches without a parameter (e.g. "advanced-tabu-list")
+ * are turned on by a non-zero value. The schedule generation scheme is selected by the "schedule-generation-scheme" option
+ * (0 - serial, 1 - parallel, 2 - mixed). The number of iterations and the time limit are the parameters of rcpsp_solve.
+ * \param value The value of the option.
+ * \return RCPSP_OK, RCPSP_INVALID_ARGUMENT if the option is unknown, the value is out of range or the instance was already solved.
+ * \brief The option of the solver is set, the options have to be set before the first rcpsp_solve call.
+ */
+int rcpsp_set_option(rcpsp_solver *solver, const char *name, double value);
+
+/*!
+ * \param solver The handle of the solver.
+ * \param maxIterations The maximal number of iterations of the tabu search.
+ * \param timeLimit The wall clock time budget of this call at seconds, the first call also pays for the initialisation of the solver.
+ * Zero means no limit.
+ * \return RCPSP_OK, RCPSP_INVALID_ARGUMENT if the configuration is invalid or RCPSP_ERROR.
+ * \brief The search runs until the budget is exhausted. The next call continues the search from the best found order
+ * with its own budget.
+ * The handles have their own configurations, different handles can be solved concurrently.
+ */
+int rcpsp_solve(rcpsp_solver *solver, uint32_t maxIterations, double timeLimit);
+
+/*!
+ * \param solver The handle of the solver.
+ * \param makespan The length of the best found schedule is written here.
+ * \return RCPSP_OK or RCPSP_NOT_SOLVED if the instance was not solved yet.
+ */
+int rcpsp_get_makespan(const rcpsp_solver *solver, uint32_t *makespan);
+
+/*!
+ * \param solver The handle of the solver.
+ * \param startTimes The array of numberOfActivities elements, the start time of each activity of the best found schedule is written here.
+ * \return RCPSP_OK or RCPSP_NOT_SOLVED if the instance was not solved yet.
+ */
+int rcpsp_get_start_times(const rcpsp_solver *solver, uint32_t *startTimes);
+
+/*! The handle and all its data are freed. NULL is ignored. */
+void rcpsp_destroy(rcpsp_solver *solver);
+
+/*! Return the description of the last error of the calling thread. The string is valid until the next failed call of the thread. */
+const char* rcpsp_error_message(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
+
@@ -0,0 +1,385 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "RCPSPServer.h"
+#include "ScheduleSolver.h"
+
+//! The maximal length of the header line of a request.
+#define MAX_HEADER_LENGTH 4096
+//! The period at milliseconds after which the poll loop checks the stop request.
+#define STOP_CHECK_PERIOD 250
+
+using namespace std;
+
+volatile sig_atomic_t RCPSPServer::stopRequested = 0;
+
+RCPSPServer::RCPSPServer(const string& socketPath, const SolverConfig& config, const uint32_t& numberOfWorkers, const uint32_t& maxIter, const double& timeLimit)
+	: socketPath(socketPath), config(config), numberOfWorkers(numberOfWorkers), maxIter(maxIter), timeLimit(timeLimit), listenSocket(-1), stopping(false)	{
+	wakeupPipe[0] = wakeupPipe[1] = -1;
+	if (socketPath.empty() || socketPath.size() >= sizeof(((sockaddr_un*) NULL)->sun_path))
+		throw invalid_argument("RCPSPServer::RCPSPServer: Invalid length of the socket path!");
+}
+
+void RCPSPServer::run()	{
+	// A stale socket of the previous run is removed, other files are never overwritten.
+	struct stat fileStatus;
+	if (lstat(socketPath.c_str(), &fileStatus) == 0)	{
+		if (!S_ISSOCK(fileStatus.st_mode))
+			throw runtime_error("RCPSPServer::run: The file \""+socketPath+"\" exists and it is not a socket!");
+		unlink(socketPath.c_str());
+	}
+
+	sockaddr_un address;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path)-1);
+
+	if ((listenSocket = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+		throw runtime_error("RCPSPServer::run: Cannot create the socket: "+string(strerror(errno))+"!");
+	if (bind(listenSocket, (sockaddr*) &address, sizeof(address)) != 0 || listen(listenSocket, SOMAXCONN) != 0)	{
+		string message = strerror(errno);
+		close(listenSocket);
+		listenSocket = -1;
+		throw runtime_error("RCPSPServer::run: Cannot listen on \""+socketPath+"\": "+message+"!");
+	}
+
+	// The workers never block on the full pipe, the main thread drains it without blocking.
+	if (pipe(wakeupPipe) != 0 || fcntl(wakeupPipe[0], F_SETFL, O_NONBLOCK) != 0 || fcntl(wakeupPipe[1], F_SETFL, O_NONBLOCK) != 0)	{
+		string message = strerror(errno);
+		close(listenSocket);
+		listenSocket = -1;
+		throw runtime_error("RCPSPServer::run: Cannot create the wake-up pipe: "+message+"!");
+	}
+
+	stopRequested = 0;
+	struct sigaction stopAction;
+	memset(&stopAction, 0, sizeof(stopAction));
+	stopAction.sa_handler = stopHandler;
+	sigemptyset(&stopAction.sa_mask);
+	sigaction(SIGINT, &stopAction, NULL);
+	sigaction(SIGTERM, &stopAction, NULL);
+
+	#ifdef _OPENMP
+	uint32_t numberOfThreads = omp_get_max_threads();
+	#else
+	uint32_t numberOfThreads = 1;
+	#endif
+	if (numberOfWorkers == 0 || numberOfWorkers > numberOfThreads)
+		numberOfWorkers = numberOfThreads;
+
+	// Each worker owns a team of threads, the team is kept alive by the OpenMP runtime between the requests.
+	vector<thread> workers;
+	for (uint32_t w = 0; w < numberOfWorkers; ++w)
+		workers.push_back(thread(&RCPSPServer::workerLoop, this, numberOfThreads/numberOfWorkers));
+
+	cout<<"Server is listening on \""<<socketPath<<"\" ("<<numberOfWorkers<<" workers, "<<numberOfThreads/numberOfWorkers<<" threads per worker)."<<endl;
+
+	// The connections whose requests are being received, the other ones are owned by the queue or the workers.
+	vector<ClientConnection> idleConnections;
+	while (stopRequested == 0)	{
+		vector<pollfd> polls;
+		pollfd listenPoll = { listenSocket, POLLIN, 0 }, wakeupPoll = { wakeupPipe[0], POLLIN, 0 };
+		polls.push_back(listenPoll);
+		polls.push_back(wakeupPoll);
+		for (vector<ClientConnection>::const_iterator it = idleConnections.begin(); it != idleConnections.end(); ++it)	{
+			pollfd clientPoll = { it->socket, POLLIN, 0 };
+			polls.push_back(clientPoll);
+		}
+
+		if (poll(&polls[0], polls.size(), STOP_CHECK_PERIOD) <= 0)
+			continue;
+
+		// The connections are visited backwards, the removal does not shift the polls of the unvisited ones.
+		for (size_t c = idleConnections.size(); c-- > 0; )	{
+			if (polls[c+2].revents == 0)
+				continue;
+			ClientConnection& connection = idleConnections[c];
+			bool idle = receiveAvailable(connection.socket, connection.buffer);
+			if (idle == false)
+				close(connection.socket);
+			else
+				idle = queueCompleteRequest(connection);
+			if (idle == false)
+				idleConnections.erase(idleConnections.begin()+c);
+		}
+
+		if (polls[1].revents != 0)	{
+			char wakeups[256];
+			while (read(wakeupPipe[0], wakeups, sizeof(wakeups)) > 0)
+				;
+
+			vector<ClientConnection> connections;
+			{
+				lock_guard<mutex> lock(queueMutex);
+				connections.swap(returnedConnections);
+			}
+			// The next request of the connection may have been received together with the previous one.
+			for (vector<ClientConnection>::iterator it = connections.begin(); it != connections.end(); ++it)	{
+				if (queueCompleteRequest(*it))
+					idleConnections.push_back(*it);
+			}
+		}
+
+		if ((polls[0].revents & POLLIN) != 0)	{
+			int clientSocket = accept(listenSocket, NULL, NULL);
+			if (clientSocket >= 0)	{
+				ClientConnection connection;
+				connection.socket = clientSocket;
+				idleConnections.push_back(connection);
+			}
+		}
+	}
+
+	{
+		lock_guard<mutex> lock(queueMutex);
+		stopping = true;
+		for (deque<ClientRequest>::const_iterator it = pendingRequests.begin(); it != pendingRequests.end(); ++it)
+			close(it->socket);
+		pendingRequests.clear();
+	}
+	queueCondition.notify_all();
+
+	for (vector<thread>::iterator it = workers.begin(); it != workers.end(); ++it)
+		it->join();
+
+	idleConnections.insert(idleConnections.end(), returnedConnections.begin(), returnedConnections.end());
+	returnedConnections.clear();
+	for (vector<ClientConnection>::const_iterator it = idleConnections.begin(); it != idleConnections.end(); ++it)
+		close(it->socket);
+
+	close(wakeupPipe[0]);
+	close(wakeupPipe[1]);
+	wakeupPipe[0] = wakeupPipe[1] = -1;
+	close(listenSocket);
+	listenSocket = -1;
+	unlink(socketPath.c_str());
+
+	cout<<"Server was stopped."<<endl;
+}
+
+void RCPSPServer::workerLoop(const uint32_t numberOfThreads)	{
+	while (true)	{
+		ClientRequest request;
+		{
+			unique_lock<mutex> lock(queueMutex);
+			while (!stopping && pendingRequests.empty())
+				queueCondition.wait(lock);
+			if (stopping)
+				return;
+			swap(request, pendingRequests.front());
+			pendingRequests.pop_front();
+		}
+
+		double queueTime = getWallClockTime()-request.receiveTime;
+		if (!sendAll(request.socket, solveRequest(request.header, request.instanceData, queueTime, numberOfThreads)))	{
+			close(request.socket);
+			continue;
+		}
+
+		{
+			lock_guard<mutex> lock(queueMutex);
+			ClientConnection connection;
+			connection.socket = request.socket;
+			connection.buffer.swap(request.nextData);
+			returnedConnections.push_back(connection);
+		}
+		char wakeup = 0;
+		if (write(wakeupPipe[1], &wakeup, 1) < 0)	{
+			// The pipe is full, i.e. the main thread will be woken up anyway.
+		}
+	}
+}
+
+bool RCPSPServer::queueCompleteRequest(ClientConnection& connection)	{
+	size_t endOfLine = connection.buffer.find('\n');
+	if (endOfLine == string::npos && connection.buffer.size() <= MAX_HEADER_LENGTH)
+		return true;
+	if (endOfLine == string::npos || endOfLine > MAX_HEADER_LENGTH)	{
+		close(connection.socket);
+		return false;
+	}
+
+	string header = connection.buffer.substr(0, endOfLine);
+	if (!header.empty() && header[header.size()-1] == '\r')
+		header.erase(header.size()-1);
+
+	string command, format;
+	uint64_t instanceSize = 0;
+	istringstream headerStream(header);
+	if (!(headerStream>>command>>format>>instanceSize) || command != "SOLVE")	{
+		rejectConnection(connection.socket, "ERROR Invalid header of the request, expected \"SOLVE FORMAT SIZE [ITERATIONS [TIME_LIMIT]]\"!\n");
+		return false;
+	}
+	if (instanceSize > DEFAULT_SERVER_MAX_REQUEST_SIZE)	{
+		rejectConnection(connection.socket, "ERROR The instance is too large!\n");
+		return false;
+	}
+	if (connection.buffer.size()-(endOfLine+1) < instanceSize)
+		return true;
+
+	ClientRequest request;
+	request.socket = connection.socket;
+	request.header = header;
+	request.instanceData = connection.buffer.substr(endOfLine+1, instanceSize);
+	request.nextData = connection.buffer.substr(endOfLine+1+instanceSize);
+	request.receiveTime = getWallClockTime();
+	{
+		lock_guard<mutex> lock(queueMutex);
+		pendingRequests.push_back(request);
+	}
+	queueCondition.notify_one();
+	return false;
+}
+
+string RCPSPServer::solveRequest(const string& header, const string& instanceData, const double& queueTime, const uint32_t& numberOfThreads) const	{
+	try {
+		string command, format;
+		uint64_t instanceSize;
+		uint32_t requestIterations = maxIter;
+		double requestTimeLimit = timeLimit;
+		istringstream headerStream(header);
+		headerStream>>command>>format>>instanceSize;
+		if (!(headerStream>>ws).eof())	{
+			if (!(headerStream>>requestIterations) || (!(headerStream>>ws).eof() && (!(headerStream>>requestTimeLimit) || requestTimeLimit < 0)))
+				throw invalid_argument("RCPSPServer::solveRequest: Invalid number of iterations or time limit!");
+		}
+
+		InputReader reader;
+		if (format == "psplib")	{
+			istringstream instanceStream(instanceData);
+			reader.readFromStream(instanceStream);
+		} else if (format == "binary")	{
+			readBinaryInstance(instanceData, reader);
+		} else {
+			throw invalid_argument("RCPSPServer::solveRequest: Unknown format \""+format+"\" of the instance!");
+		}
+
+		ScheduleSolver solver(reader, numberOfThreads, config);
+		solver.solveSchedule(requestIterations, "", requestTimeLimit);
+
+		vector<uint32_t> startTimes;
+		uint32_t makespan = solver.getBestSchedule(startTimes);
+
+		ostringstream reply;
+		reply<<"OK "<<makespan<<" "<<solver.getTotalRunTime()<<" "<<solver.getTimeToBest()<<" "<<solver.getNumberOfEvaluatedSchedules()<<" "<<queueTime<<"\n";
+		for (vector<uint32_t>::const_iterator it = startTimes.begin(); it != startTimes.end(); ++it)
+			reply<<(it != startTimes.begin() ? " " : "")<<*it;
+		reply<<"\n";
+		return reply.str();
+	} catch (exception& e)	{
+		string message = e.what();
+		replace(message.begin(), message.end(), '\n', ' ');
+		return "ERROR "+message+"\n";
+	}
+}
+
+void RCPSPServer::readBinaryInstance(const string& instanceData, InputReader& reader)	{
+	if (instanceData.size() % sizeof(uint32_t) != 0 || instanceData.size() < 2*sizeof(uint32_t))
+		throw invalid_argument("RCPSPServer::readBinaryInstance: Invalid size of the binary instance!");
+
+	vector<uint32_t> values(instanceData.size()/sizeof(uint32_t));
+	memcpy(&values[0], instanceData.data(), instanceData.size());
+
+	uint64_t numberOfActivities = values[0], numberOfResources = values[1];
+	if (numberOfActivities > values.size() || numberOfResources > values.size())
+		throw invalid_argument("RCPSPServer::readBinaryInstance: The binary instance is truncated!");
+	uint64_t successorsOffset = 2+2*numberOfActivities+numberOfResources+numberOfActivities*numberOfResources;
+	if (successorsOffset > values.size())
+		throw invalid_argument("RCPSPServer::readBinaryInstance: The binary instance is truncated!");
+
+	const uint32_t *durations = &values[2], *capacities = durations+numberOfActivities;
+	const uint32_t *requirements = capacities+numberOfResources, *numberOfSuccessors = requirements+numberOfActivities*numberOfResources;
+	uint64_t totalNumberOfSuccessors = 0;
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)
+		totalNumberOfSuccessors += numberOfSuccessors[activityId];
+	if (successorsOffset+totalNumberOfSuccessors != values.size())
+		throw invalid_argument("RCPSPServer::readBinaryInstance: The number of successors does not correspond to the size of the binary instance!");
+
+	// The successors are empty if no activity has a successor.
+	const uint32_t *successors = (successorsOffset < values.size() ? &values[successorsOffset] : NULL);
+	reader.readFromArrays(numberOfActivities, numberOfResources, durations, capacities, requirements, numberOfSuccessors, successors);
+}
+
+bool RCPSPServer::receiveAvailable(const int& socket, string& buffer)	{
+	char data[65536];
+	ssize_t received = recv(socket, data, sizeof(data), MSG_DONTWAIT);
+	if (received < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+		return true;
+	if (received <= 0)
+		return false;
+	buffer.append(data, received);
+	return true;
+}
+
+void RCPSPServer::rejectConnection(const int& socket, const string& message)	{
+	// The main thread is not blocked by a client that does not read the replies.
+	send(socket, message.data(), message.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+	close(socket);
+}
+
+bool RCPSPServer::sendAll(const int& socket, const string& data)	{
+	size_t sent = 0;
+	while (sent < data.size())	{
+		// The server is not terminated by SIGPIPE if the client closed the connection.
+		ssize_t status = send(socket, data.data()+sent, data.size()-sent, MSG_NOSIGNAL);
+		if (status < 0 && errno == EINTR)
+			continue;
+		if (status <= 0)
+			return false;
+		sent += status;
+	}
+	return true;
+}
+
+void RCPSPServer::stopHandler(int)	{
+	stopRequested = 1;
+}
+
+double RCPSPServer::getWallClockTime()	{
+	timeval currentTime;
+	gettimeofday(&currentTime, NULL);
+	return currentTime.tv_sec+currentTime.tv_usec/1000000.;
+}
+
+RCPSPServer::~RCPSPServer()	{
+	if (listenSocket >= 0)	{
+		close(listenSocket);
+		unlink(socketPath.c_str());
+	}
+}
+
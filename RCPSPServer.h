@@ -0,0 +1,208 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef HLIDAC_PES_RCPSP_SERVER_H
+#define HLIDAC_PES_RCPSP_SERVER_H
+
+/*!
+ * \file RCPSPServer.h
+ * \author Libor Bukata
+ * \brief The solver daemon that accepts instances over a local Unix socket.
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <csignal>
+#include <stdint.h>
+#include "ConfigureRCPSP.h"
+#include "InputReader.h"
+
+/*!
+ * The server listens on a Unix domain socket and keeps a fixed pool of worker threads, each worker solves one instance
+ * at a time by its own team of OpenMP threads. The teams are created by the first solved instance and they are reused
+ * by the next ones, the instances are not delayed by the creation of the threads. The main thread polls the listening
+ * socket and all idle connections, a request is queued for the workers only after its header and the whole instance
+ * were received. An idle or slow client therefore never occupies a worker. The queued requests are served in the order
+ * of their completion, the connection is given back to the main thread after the reply.
+ *
+ * A client can send more requests through one connection, each request consists of a header line and the instance:
+ *
+ *     SOLVE FORMAT SIZE [ITERATIONS [TIME_LIMIT]]
+ *
+ * FORMAT is "psplib" (the text of a PSPLIB file) or "binary". SIZE is the number of bytes of the instance that follow
+ * the header line. ITERATIONS and TIME_LIMIT (seconds) override the values of the server for the request.
+ * The binary instance is a sequence of the 32-bit unsigned integers in the byte order of the server: the number of
+ * activities n, the number of resources r, n durations, r capacities, n*r requirements (row-major), n numbers of successors
+ * and the successors of all activities (see InputReader::readFromArrays). The server replies with the lines
+ *
+ *     OK MAKESPAN SOLVE_TIME TIME_TO_BEST EVALUATED_SCHEDULES QUEUE_TIME
+ *     START_TIME_OF_ACTIVITY_1 ... START_TIME_OF_ACTIVITY_N
+ *
+ * or "ERROR message" if the request cannot be processed. The times are at seconds, the queue time is the time
+ * the received request waited for a free worker. The connection is closed after a malformed header, a too long header
+ * line or an oversized instance.
+ * \class RCPSPServer
+ * \brief The daemon that solves the instances sent by the clients with a warm pool of threads.
+ */
+class RCPSPServer {
+	public:
+		/*!
+		 * \param socketPath The path of the Unix socket.
+		 * \param config The configuration of the solvers.
+		 * \param numberOfWorkers The number of instances solved concurrently. If zero then one instance per hardware thread.
+		 * \param maxIter The default number of iterations of the tabu search.
+		 * \param timeLimit The default time limit of one instance at seconds. Zero means no limit.
+		 * \exception invalid_argument The socket path is empty or too long.
+		 * \brief It prepares the server, the socket is created by the run method.
+		 */
+		RCPSPServer(const std::string& socketPath, const SolverConfig& config, const uint32_t& numberOfWorkers, const uint32_t& maxIter, const double& timeLimit);
+
+		/*!
+		 * \exception runtime_error The socket cannot be created or bound to the path.
+		 * \brief It starts the workers and receives the requests until SIGINT or SIGTERM is received.
+		 * The queued requests and the idle connections are closed, the workers finish their current requests
+		 * and the socket file is removed.
+		 */
+		void run();
+
+		//! The socket file is removed if it still exists.
+		~RCPSPServer();
+
+	private:
+
+		//! Copy constructor is forbidden.
+		RCPSPServer(const RCPSPServer&);
+		//! Assignment operator is forbidden.
+		RCPSPServer& operator=(const RCPSPServer&);
+
+		/*!
+		 * \struct ClientConnection
+		 * \brief The connection that is polled by the main thread.
+		 */
+		struct ClientConnection {
+			//! The socket of the connection.
+			int socket;
+			//! The received bytes that were not processed yet.
+			std::string buffer;
+		};
+
+		/*!
+		 * \struct ClientRequest
+		 * \brief The completely received request that waits for a worker.
+		 */
+		struct ClientRequest {
+			//! The socket of the connection.
+			int socket;
+			//! The header line of the request.
+			std::string header;
+			//! The instance that follows the header.
+			std::string instanceData;
+			//! The received bytes of the next requests of the connection.
+			std::string nextData;
+			//! The wall clock time when the request was completely received.
+			double receiveTime;
+		};
+
+		/*!
+		 * \param numberOfThreads The number of threads solving one instance.
+		 * \brief The worker takes the requests from the queue and solves them until the server is stopped.
+		 * The connection is given back to the main thread after the reply.
+		 */
+		void workerLoop(const uint32_t numberOfThreads);
+		/*!
+		 * \param connection The connection with the received bytes.
+		 * \return True if the connection remains idle, false if its request was queued or the connection was closed.
+		 * \brief If the buffer contains a complete request then the request is queued for the workers.
+		 * The connection is closed after a malformed header, a too long header line or an oversized instance.
+		 */
+		bool queueCompleteRequest(ClientConnection& connection);
+		/*!
+		 * \param header The header line of the request.
+		 * \param instanceData The instance that follows the header.
+		 * \param queueTime The time that the request waited for a worker at seconds.
+		 * \param numberOfThreads The number of threads solving the instance.
+		 * \return The reply to the request.
+		 * \brief The instance is read and solved, the read and solve errors are reported by the "ERROR" reply.
+		 */
+		std::string solveRequest(const std::string& header, const std::string& instanceData, const double& queueTime, const uint32_t& numberOfThreads) const;
+
+		/*!
+		 * \param instanceData The instance in the binary format.
+		 * \param reader The reader that is filled with the instance.
+		 * \exception invalid_argument The size of the data does not correspond to the numbers of the activities, resources and successors.
+		 * \brief The binary instance is decoded and passed to InputReader::readFromArrays.
+		 */
+		static void readBinaryInstance(const std::string& instanceData, InputReader& reader);
+		/*!
+		 * \param socket The socket of the connection.
+		 * \param buffer The received bytes are appended to the buffer.
+		 * \return False if the connection was closed by the client or it failed.
+		 * \brief It receives the available data of the client without blocking.
+		 */
+		static bool receiveAvailable(const int& socket, std::string& buffer);
+		/*!
+		 * \param socket The socket of the connection.
+		 * \param message The error reply.
+		 * \brief The error reply is sent without blocking and the connection is closed.
+		 */
+		static void rejectConnection(const int& socket, const std::string& message);
+		/*!
+		 * \param socket The socket of the connection.
+		 * \param data The sent data.
+		 * \return False if the data cannot be sent, e.g. the client closed the connection.
+		 */
+		static bool sendAll(const int& socket, const std::string& data);
+		/*!
+		 * \param signalNumber The number of the received signal.
+		 * \brief The signal handler that stops the server.
+		 */
+		static void stopHandler(int signalNumber);
+		//! Return the current wall clock time at seconds.
+		static double getWallClockTime();
+
+		//! The path of the Unix socket.
+		const std::string socketPath;
+		//! The configuration of the solvers.
+		const SolverConfig config;
+		//! The number of instances solved concurrently.
+		uint32_t numberOfWorkers;
+		//! The default number of iterations.
+		const uint32_t maxIter;
+		//! The default time limit of one instance.
+		const double timeLimit;
+		//! The listening socket or -1 if the server is not running.
+		int listenSocket;
+		//! The pipe through which the workers wake up the main thread when they give back a connection.
+		int wakeupPipe[2];
+		//! The completely received requests in the order of their completion.
+		std::deque<ClientRequest> pendingRequests;
+		//! The connections given back by the workers that are not polled by the main thread yet.
+		std::vector<ClientConnection> returnedConnections;
+		//! It guards the queue of the requests and the returned connections.
+		std::mutex queueMutex;
+		//! The workers wait for a request or the end of the server.
+		std::condition_variable queueCondition;
+		//! The workers finish if it is true.
+		bool stopping;
+		//! It is set by the signal handler.
+		static volatile sig_atomic_t stopRequested;
+};
+
+#endif
+
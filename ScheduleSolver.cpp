@@ -15,16 +15,21 @@
 	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
 */
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <list>
+#include <queue>
 #include <fstream>
 #include <set>
 #include <string>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 #ifdef __GNUC__
 #include <sys/time.h>
@@ -32,28 +37,40 @@
 #include <Windows.h>
 #endif
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "AdvancedTabuList.h"
 #include "ScheduleSolver.h"
 #include "SimpleTabuList.h"
 #include "SourcesLoadCapacityResolution.h"
+#include "SourcesLoadCompressedCapacityResolution.h"
 #include "SourcesLoadTimeResolution.h"
 
 #ifndef UINT32_MAX
 #define UINT32_MAX 0xffffffff
 #endif
 
-using namespace std;
+//! The sections of the instance arena are aligned to the cache line size.
+#define INSTANCE_ARENA_ALIGNMENT 64
+//! The time resolution stores the resources up to the best makespan increased by this percentage.
+#define TIME_HORIZON_MARGIN 25
 
-ScheduleSolver::ScheduleSolver(const InputReader& rcpspData) : tabu(NULL), totalRunTime(0), numberOfEvaluatedSchedules(0) 	{
-	// Copy pointers to data of instance.
-	instance.numberOfResources = rcpspData.getNumberOfResources();
-	instance.capacityOfResources = rcpspData.getCapacityOfResources();
-	instance.numberOfActivities = rcpspData.getNumberOfActivities();
-	instance.durationOfActivities = rcpspData.getActivitiesDuration();
-	instance.numberOfSuccessors = rcpspData.getActivitiesNumberOfSuccessors();
-	instance.successorsOfActivity = rcpspData.getActivitiesSuccessors();
-	instance.requiredResourcesOfActivities = rcpspData.getActivitiesResources();
+using namespace std;
 
+ScheduleSolver::ScheduleSolver(const InputReader& rcpspData, const uint32_t& threads, const SolverConfig& solverConfig) : config(solverConfig), trajectories(NULL), numberOfIslands(config.numberOfIslands), elitePool(NULL), numaTopology(NULL), evaluationCache(NULL), setupTime(0), totalRunTime(0), timeToBest(0)	{
+	// Copy data of instance to the arena.
+	initialiseInstanceArena(instance, rcpspData, config.renumberActivities);
+
+	if (numberOfIslands == 0)
+		throw invalid_argument("ScheduleSolver::ScheduleSolver: The number of islands has to be positive!");
+	if (config.neighbourhoodSamplePercentage == 0 || config.neighbourhoodSamplePercentage > 100)
+		throw invalid_argument("ScheduleSolver::ScheduleSolver: The neighbourhood sample percentage has to be from the range 1-100!");
+	if (config.lowerBoundFilter == true && config.scheduleGenerationScheme != SERIAL_SGS)
+		throw invalid_argument("ScheduleSolver::ScheduleSolver: The lower bound filter requires the serial schedule generation scheme!");
+	if (config.criticalNeighbourhood == true && config.criticalNeighbourhoodFullScanInterval == 0)
+		throw invalid_argument("ScheduleSolver::ScheduleSolver: The interval of the full neighbourhood scans has to be positive!");
 	#ifdef __GNUC__
 	timeval startTime, endTime, diffTime;
 	gettimeofday(&startTime, NULL);
@@ -64,269 +81,1166 @@ ScheduleSolver::ScheduleSolver(const InputReader& rcpspData) : tabu(NULL), total
 	QueryPerformanceCounter(&startTimeStamp);
 	#endif
 
-	// Create desired type of tabu list.
-	if (ConfigureRCPSP::TABU_LIST_TYPE == SIMPLE_TABU)
-		tabu = new SimpleTabuList(instance.numberOfActivities, ConfigureRCPSP::SIMPLE_TABU_LIST_SIZE);
-	else if (ConfigureRCPSP::TABU_LIST_TYPE == ADVANCED_TABU)
-		tabu = new AdvancedTabuList(ConfigureRCPSP::MAXIMAL_NUMBER_OF_ITERATIONS_SINCE_BEST);
-	else
-		throw invalid_argument("ScheduleSolver::ScheduleSolver: Invalid type of tabu list!");
+	// Available threads are divided among islands.
+	#ifdef _OPENMP
+	uint32_t numberOfThreads = (threads > 0 ? threads : omp_get_max_threads());
+	#else
+	uint32_t numberOfThreads = 1;
+	#endif
+	const uint32_t availableThreads = numberOfThreads;
+	// Each thread is a walker (portfolio member) if the number of islands is not set.
+	if (numberOfIslands == 1 && config.portfolioMode == true)
+		numberOfIslands = max(numberOfThreads, 2u);
+	else if (numberOfIslands == 1 && config.asynchronousSearch == true)
+		numberOfIslands = numberOfThreads;
+	if (numberOfIslands > 1 && config.islandExchangeInterval == 0)
+		throw invalid_argument("ScheduleSolver::ScheduleSolver: The exchange interval of islands has to be positive!");
+	if (numberOfIslands > 1)	{
+		if (config.threadsPerIsland > 0 && threads == 0)
+			numberOfThreads = config.threadsPerIsland;
+		else
+			numberOfThreads = max(numberOfThreads/numberOfIslands, 1u);
+	}
+
+	// Each trajectory has its own generator, the next calls of solveSchedule continue the sequences.
+	uint32_t randomSeed = (config.randomSeed != 0 ? config.randomSeed : (uint32_t) time(NULL));
+	trajectories = new SearchTrajectory[numberOfIslands];
+	for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+		SearchTrajectory& trajectory = trajectories[island];
+		trajectory.solution.orderOfActivities = trajectory.solution.bestScheduleOrder = NULL;
+		trajectory.tabu = NULL;
+		trajectory.algo = CAPACITY_RESOLUTION;
+		trajectory.reqTimePerIterForTimeResAlg = trajectory.reqTimePerIterForCapacityResAlg = 0;
+		trajectory.iteration = trajectory.numberOfIterSinceBest = 0;
+		trajectory.numberOfThreads = numberOfThreads;
+		trajectory.numberOfEvaluatedSchedules = trajectory.numberOfCacheHits = 0;
+		trajectory.nextRecentOrderHash = 0;
+		trajectory.prunedAfterCycle = false;
+		trajectory.numberOfDetectedCycles = trajectory.numberOfCycleDiversifications = 0;
+		trajectory.numberOfSavedIterations = 0;
+		trajectory.numberOfPrunedMoves = 0;
+		trajectory.lowerBoundData.startTimesById = trajectory.lowerBoundData.positionOfActivity = NULL;
+		trajectory.lowerBoundData.prefixMakespanBound = trajectory.lowerBoundData.prefixPenalty = NULL;
+		if (config.lowerBoundFilter == true)	{
+			trajectory.lowerBoundData.startTimesById = new uint32_t[instance.numberOfActivities];
+			trajectory.lowerBoundData.positionOfActivity = new uint32_t[instance.numberOfActivities];
+			trajectory.lowerBoundData.prefixMakespanBound = new uint32_t[instance.numberOfActivities+1];
+			trajectory.lowerBoundData.prefixPenalty = new uint32_t[instance.numberOfActivities+1];
+		}
+		trajectory.criticalActivities = NULL;
+		trajectory.criticalStartTimesById = NULL;
+		trajectory.numberOfRestrictedIterations = 0;
+		trajectory.numberOfCriticalActivities = 0;
+		if (config.criticalNeighbourhood == true)	{
+			trajectory.criticalActivities = new uint8_t[instance.numberOfActivities];
+			trajectory.criticalStartTimesById = new uint32_t[instance.numberOfActivities];
+		}
+		trajectory.timeOfBestSolution = 0;
+		trajectory.randomState = (randomSeed^((island+1)*2654435761u)) | 1u;
+		trajectory.evaluationCache = evaluationCache;
+		trajectory.config = &config;
+		trajectory.project = &instance;
+		trajectory.numaTopology = NULL;
+		trajectory.numaNode = 0;
+		trajectory.usedNumaNode = -1;
+		trajectory.tabuType = config.tabuListType;
+		trajectory.swapRange = config.swapRange;
+		trajectory.tabuListSize = config.simpleTabuListSize;
+		if (config.portfolioMode == true)
+			setPortfolioMember(island, trajectory);
+		trajectory.speculationValid = false;
+		trajectory.speculativeOrder = new uint32_t[instance.numberOfActivities];
+		trajectory.orderHash = 0;
+		trajectory.orderHashValid = false;
+	}
 
 	// Create initial solution and fill required data structures.
-	initialiseInstanceDataAndInitialSolution(instance, instanceSolution);
+	initialiseInstanceDataAndInitialSolution(instance, trajectories[0].solution, availableThreads, config.priorityRulePasses);
+
+	// Create desired type of tabu list for each island.
+	for (uint32_t island = 0; island < numberOfIslands; ++island)
+		trajectories[island].tabu = createTabuList(instance, config, trajectories[island].tabuType, trajectories[island].tabuListSize);
+
+	if (numberOfIslands > 1)	{
+		copyInitialSolutionToIslands();
+		elitePool = new ElitePool(instance.numberOfActivities, numberOfIslands);
+	}
+
+	if (numberOfIslands > 1 && config.numaAware == true)	{
+		numaTopology = new NumaTopology();
+		createNumaReplicas();
+	}
 
 	#ifdef __GNUC__
 	gettimeofday(&endTime, NULL);
 	timersub(&endTime, &startTime, &diffTime);
-	totalRunTime += diffTime.tv_sec+diffTime.tv_usec/1000000.;
+	setupTime += diffTime.tv_sec+diffTime.tv_usec/1000000.;
 	#elif defined _WIN32 || defined _WIN64 || defined WIN32 || defined WIN64
 	QueryPerformanceCounter(&stopTimeStamp);
-	totalRunTime += (stopTimeStamp.QuadPart-startTimeStamp.QuadPart)/((double) ticksPerSecond.QuadPart);
+	setupTime += (stopTimeStamp.QuadPart-startTimeStamp.QuadPart)/((double) ticksPerSecond.QuadPart);
 	#endif
+
+	// The initial solution is the best one so far.
+	totalRunTime = timeToBest = setupTime;
+}
+
+void ScheduleSolver::setInitialSolution(const vector<uint32_t>& order)	{
+	double startTime = getWallClockTime();
+	const uint32_t numberOfActivities = instance.numberOfActivities;
+	if (order.size() != numberOfActivities)
+		throw invalid_argument("ScheduleSolver::setInitialSolution: The order does not contain all activities of the instance!");
+
+	vector<bool> orderedActivities(numberOfActivities, false);
+	vector<uint32_t> internalOrder(numberOfActivities);
+	for (uint32_t position = 0; position < numberOfActivities; ++position)	{
+		uint32_t originalId = order[position];
+		if (originalId >= numberOfActivities || orderedActivities[originalId] == true)
+			throw invalid_argument("ScheduleSolver::setInitialSolution: The order is not a permutation of the activities!");
+		orderedActivities[originalId] = true;
+		internalOrder[position] = internalActivityId(instance, originalId, "setInitialSolution");
+	}
+
+	startSearchFromOrder(&internalOrder[0]);
+
+	setupTime += getWallClockTime()-startTime;
+}
+
+void ScheduleSolver::setInitialSolution(const string& filename)	{
+	setInitialSolution(readWarmStartOrder(filename, instance.numberOfActivities));
+}
+
+void ScheduleSolver::changeActivityDuration(const uint32_t& activityId, const uint32_t& duration)	{
+	double startTime = getWallClockTime();
+	uint32_t id = internalActivityId(instance, activityId, "changeActivityDuration");
+	instance.durationOfActivities[id] = duration;
+	computeInstanceBounds(instance);
+	continueAfterInstanceChange(startTime);
+}
+
+void ScheduleSolver::changeResourceRequirement(const uint32_t& activityId, const uint32_t& resourceId, const uint32_t& demand)	{
+	double startTime = getWallClockTime();
+	uint32_t id = internalActivityId(instance, activityId, "changeResourceRequirement");
+	if (resourceId >= instance.numberOfResources)
+		throw invalid_argument("ScheduleSolver::changeResourceRequirement: Invalid resource id!");
+	if (demand > instance.capacityOfResources[resourceId])
+		throw invalid_argument("ScheduleSolver::changeResourceRequirement: The requirement exceeds the capacity of the resource!");
+
+	uint32_t& requirement = instance.requiredResourcesOfActivities[id][resourceId];
+	bool requirementDecreased = (demand < requirement);
+	if ((requirement == 0) != (demand == 0))	{
+		// The number of the non-zero requirements is changed, the sections of the arena have different sizes.
+		requirement = demand;
+		rebuildInstanceArena(instance, getSuccessorLists(instance));
+	} else {
+		requirement = demand;
+		for (ResourceRequirement *req = instance.resourceRequirements+instance.requirementsOffsets[id]; req < instance.resourceRequirements+instance.requirementsOffsets[id+1]; ++req)	{
+			if (req->resourceId == resourceId)
+				req->demand = demand;
+		}
+	}
+
+	// The critical path does not depend on the resources. The longest paths to the end activity include the energy
+	// reasoning, they remain valid (possibly weaker) lower bounds if the requirement grows.
+	if (requirementDecreased)
+		computeRightLeftLongestPaths(instance);
+	continueAfterInstanceChange(startTime);
+}
+
+void ScheduleSolver::changeResourceCapacity(const uint32_t& resourceId, const uint32_t& capacity)	{
+	double startTime = getWallClockTime();
+	if (resourceId >= instance.numberOfResources)
+		throw invalid_argument("ScheduleSolver::changeResourceCapacity: Invalid resource id!");
+	for (uint32_t id = 0; id < instance.numberOfActivities; ++id)	{
+		if (instance.requiredResourcesOfActivities[id][resourceId] > capacity)
+			throw invalid_argument("ScheduleSolver::changeResourceCapacity: The capacity is lower than a requirement of an activity!");
+	}
+
+	bool capacityIncreased = (capacity > instance.capacityOfResources[resourceId]);
+	instance.capacityOfResources[resourceId] = capacity;
+	// The capacity can change the type of the stored capacities, the longest paths are recomputed only if the resource is relaxed.
+	selectValueTypes(instance);
+	if (capacityIncreased)
+		computeRightLeftLongestPaths(instance);
+	continueAfterInstanceChange(startTime);
+}
+
+void ScheduleSolver::addPrecedence(const uint32_t& activityId, const uint32_t& successorId)	{
+	double startTime = getWallClockTime();
+	uint32_t i = internalActivityId(instance, activityId, "addPrecedence");
+	uint32_t j = internalActivityId(instance, successorId, "addPrecedence");
+	const vector<uint32_t>& successorsOfSuccessor = *instance.allSuccessorsCache[j];
+	if (i == j || binary_search(successorsOfSuccessor.begin(), successorsOfSuccessor.end(), i))
+		throw invalid_argument("ScheduleSolver::addPrecedence: The edge would create a cycle!");
+	if (instance.matrixOfSuccessors[i][j] == 1)
+		throw invalid_argument("ScheduleSolver::addPrecedence: The edge already exists!");
+
+	changePrecedenceEdge(i, j, true);
+	continueAfterInstanceChange(startTime);
+}
+
+void ScheduleSolver::removePrecedence(const uint32_t& activityId, const uint32_t& successorId)	{
+	double startTime = getWallClockTime();
+	uint32_t i = internalActivityId(instance, activityId, "removePrecedence");
+	uint32_t j = internalActivityId(instance, successorId, "removePrecedence");
+	if (instance.matrixOfSuccessors[i][j] != 1)
+		throw invalid_argument("ScheduleSolver::removePrecedence: The edge does not exist!");
+	// Otherwise the activity would become another source (sink) of the precedence graph.
+	if ((i == 0 && instance.numberOfPredecessors[j] == 1) || (j == instance.numberOfActivities-1 && instance.numberOfSuccessors[i] == 1))
+		throw invalid_argument("ScheduleSolver::removePrecedence: The last edge from the start activity or to the end activity cannot be removed!");
+
+	changePrecedenceEdge(i, j, false);
+	continueAfterInstanceChange(startTime);
+}
+
+void ScheduleSolver::solveSchedule(const uint32_t& maxIter, const string& graphFilename, const double& timeLimit)	{
+	double startTime = getWallClockTime();
+	// The budget of the call includes the setup work done since the previous call, e.g. the initialisation.
+	double deadline = startTime+timeLimit-setupTime;
+	if (timeLimit <= 0)
+		deadline = numeric_limits<double>::infinity();
+
+	for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+		trajectories[island].numberOfEvaluatedSchedules = trajectories[island].numberOfCacheHits = 0;
+		trajectories[island].numberOfDetectedCycles = trajectories[island].numberOfCycleDiversifications = 0;
+		trajectories[island].numberOfSavedIterations = 0;
+		trajectories[island].numberOfPrunedMoves = 0;
+		trajectories[island].numberOfRestrictedIterations = 0;
+		trajectories[island].numberOfCriticalActivities = 0;
+		trajectories[island].timeOfBestSolution = 0;
+	}
+
+	prepareEvaluationCache(maxIter);
+
+	if (numberOfIslands > 1 && config.asynchronousSearch == true)	{
+		solveScheduleAsynchronously(maxIter, deadline);
+	} else if (numberOfIslands > 1)	{
+		solveScheduleIslands(maxIter, deadline);
+	} else {
+		SearchTrajectory& trajectory = trajectories[0];
+		FILE *graphFile = NULL;
+		if (!graphFilename.empty())	{
+			graphFile = fopen(graphFilename.c_str(), "w");
+			if (graphFile == NULL)	{
+				cerr<<"ScheduleSolver::solveSchedule: Cannot write csv file! Check permissions."<<endl;
+			}	else	{
+				fprintf(graphFile, "Iteration number; Current criterion; Current best known makespan;\n");
+				fprintf(graphFile, "0; %u; %u;\n", trajectory.solution.costOfBestSchedule, trajectory.solution.costOfBestSchedule);
+			}
+		}
+
+		for (uint32_t iter = 0; iter < maxIter && ((uint32_t) instance.criticalPathMakespan) < trajectory.solution.costOfBestSchedule; ++iter)	{
+			if (getWallClockTime() >= deadline)
+				break;
+			performSearchIteration(instance, trajectory, graphFile);
+		}
+
+		if (graphFile != NULL)	{
+			fclose(graphFile);
+		}
+	}
+
+	// The main thread was bound to a NUMA node as the master thread of the only island.
+	if (numberOfIslands == 1)
+		unbindTrajectoryThread(trajectories[0]);
+
+	// The best solution is available from the start of the call if it was not improved by this call.
+	const SearchTrajectory& bestTrajectory = getBestTrajectory();
+	timeToBest = setupTime;
+	if (bestTrajectory.timeOfBestSolution >= startTime)
+		timeToBest += bestTrajectory.timeOfBestSolution-startTime;
+
+	totalRunTime = setupTime+getWallClockTime()-startTime;
+	setupTime = 0;
 }
 
-void ScheduleSolver::solveSchedule(const uint32_t& maxIter, const string& graphFilename)	{
+void ScheduleSolver::performSearchIteration(const InstanceData& project, SearchTrajectory& trajectory, FILE *graphFile)	{
 	#ifdef __GNUC__
-	timeval startTime, endTime, diffTime;
 	timeval startTimeIter, endTimeIter, diffTimeIter;
-	gettimeofday(&startTime, NULL);
 	#elif defined _WIN32 || defined _WIN64 || defined WIN32 || defined WIN64
 	LARGE_INTEGER ticksPerSecond;
-	LARGE_INTEGER startTimeStamp, stopTimeStamp;
 	LARGE_INTEGER startTimeIterStamp, stopTimeIterStamp;
 	QueryPerformanceFrequency(&ticksPerSecond);
-	QueryPerformanceCounter(&startTimeStamp); 
 	#endif
 
-	srand(time(NULL));
-	numberOfEvaluatedSchedules = 0;
-	uint32_t numberOfIterSinceBest = 0;
-	FILE *graphFile = NULL;
-	if (ConfigureRCPSP::WRITE_GRAPH == true && !graphFilename.empty())	{
-		graphFile = fopen(graphFilename.c_str(), "w");
-		if (graphFile == NULL)	{
-			cerr<<"ScheduleSolver::solveSchedule: Cannot write csv file! Check permissions."<<endl;
-		}	else	{
-			fprintf(graphFile, "Iteration number; Current criterion; Current best known makespan;\n");
-			fprintf(graphFile, "0; %u; %u;\n", instanceSolution.costOfBestSchedule, instanceSolution.costOfBestSchedule);
-		}
+	const uint32_t iter = trajectory.iteration;
+	const InstanceSolution& instanceSolution = trajectory.solution;
+	const TabuList *tabu = trajectory.tabu;
+
+	size_t neighborhoodSize = 0;
+	EvaluatedMove iterBestMove = { NONE, 0, 0, UINT32_MAX };
+
+	if ((iter % 100) == 0 || (iter % 100) == 1)	{
+		#ifdef __GNUC__
+		gettimeofday(&startTimeIter, NULL);
+		#elif defined _WIN32 || defined _WIN64 || defined WIN32 || defined WIN64
+		QueryPerformanceCounter(&startTimeIterStamp); 
+		#endif
+		trajectory.algo = (iter % 100) == 0 ? CAPACITY_RESOLUTION : TIME_RESOLUTION;
 	}
 
-	for (uint32_t iter = 0; iter < maxIter && ((uint32_t) instance.criticalPathMakespan) < instanceSolution.costOfBestSchedule; ++iter)	{
-		size_t neighborhoodSize = 0;
-		MoveType iterBestMove = NONE;
-		uint32_t iterBestI = 0, iterBestJ = 0, iterShiftDiff = 0;
-		uint32_t iterBestEval = UINT32_MAX;
+	if ((iter % 100) == 2)
+		trajectory.algo = trajectory.reqTimePerIterForCapacityResAlg < trajectory.reqTimePerIterForTimeResAlg ? CAPACITY_RESOLUTION : TIME_RESOLUTION;
+
+	const EvaluationAlgorithm algo = trajectory.algo;
+	const bool speculative = trajectory.config->speculativeEvaluation;
+	// Rows evaluated speculatively in the previous iteration can be reused only if the speculated move was applied.
+	const bool reuseSpeculativeRows = speculative && trajectory.speculationValid;
+	if (speculative)	{
+		// It is invalidated by finishSearchIteration if the order or the penalty base is changed otherwise.
+		trajectory.speculationValid = true;
+		trajectory.speculativeRows.resize(project.numberOfActivities);
+		trajectory.nextSpeculativeRows.resize(project.numberOfActivities);
+		trajectory.nextSpeculativeRowReady.assign(project.numberOfActivities, 0);
+		if (!reuseSpeculativeRows)
+			trajectory.speculativeRowReady.assign(project.numberOfActivities, 0);
+	}
 
-		if ((iter % 100) == 0 || (iter % 100) == 1)	{
-			#ifdef __GNUC__
-			gettimeofday(&startTimeIter, NULL);
-			#elif defined _WIN32 || defined _WIN64 || defined WIN32 || defined WIN64
-			QueryPerformanceCounter(&startTimeIterStamp); 
-			#endif
-			algo = (iter % 100) == 0 ? CAPACITY_RESOLUTION : TIME_RESOLUTION;
+	// Randomly selected rows of the neighbourhood are evaluated if the neighbourhood is sampled.
+	const bool sampling = (trajectory.config->neighbourhoodSamplePercentage < 100);
+	if (sampling == true)	{
+		trajectory.sampledRows.assign(project.numberOfActivities, 0);
+		for (uint32_t i = 1; i < project.numberOfActivities-1; ++i)	{
+			if (generateRandomNumber(trajectory.randomState) % 100 < trajectory.config->neighbourhoodSamplePercentage)
+				trajectory.sampledRows[i] = 1;
 		}
+	}
+
+	// The hashes of the neighbour orders are derived from the hash of the current order.
+	EvaluationCache *cache = trajectory.evaluationCache;
+	const uint64_t orderHash = (cache != NULL ? currentOrderHash(project, trajectory) : 0);
+
+	// The prefixes of the neighbour orders are scheduled as in the schedule of the current order.
+	const MoveLowerBoundData *lowerBoundData = NULL;
+	uint64_t evaluatedSchedulesInIteration = 0, cacheHitsInIteration = 0, prunedMovesInIteration = 0;
+	if (trajectory.config->lowerBoundFilter == true)	{
+		computeMoveLowerBoundData(project, instanceSolution, algo, trajectory.lowerBoundData);
+		lowerBoundData = &trajectory.lowerBoundData;
+		++evaluatedSchedulesInIteration;
+	}
+
+	// The probe iterations of the evaluation algorithms are full scans, so their times are comparable.
+	const uint8_t *criticalActivities = NULL;
+	if (trajectory.config->criticalNeighbourhood == true && (iter % 100) > 1 && (iter % trajectory.config->criticalNeighbourhoodFullScanInterval) != 0)	{
+		trajectory.numberOfCriticalActivities += computeCriticalActivities(project, instanceSolution, algo, trajectory.config->scheduleGenerationScheme, trajectory.criticalStartTimesById, trajectory.criticalActivities);
+		criticalActivities = trajectory.criticalActivities;
+		++trajectory.numberOfRestrictedIterations;
+		++evaluatedSchedulesInIteration;
+	}
+
+	// Shared data of the speculation.
+	bool speculationStarted = false, iterationFinished = false;
+	uint64_t speculativeOrderHash = 0;
+	uint32_t finishedThreads = 0, nextSpeculativeRow = 1;
+	InstanceSolution speculativeSolution = instanceSolution;
+	EvaluatedMove speculatedMove = iterBestMove;
+	string iterationError;
+
+	#pragma omp parallel num_threads(trajectory.numberOfThreads) reduction(+:evaluatedSchedulesInIteration,cacheHitsInIteration,prunedMovesInIteration)
+	{
+		bindTrajectoryThread(trajectory);
+
+		/* PRIVATE DATA FOR EVERY THREAD */
+		EvaluatedMove threadBestMove = { NONE, 0, 0, UINT32_MAX };
+		size_t threadNeighborhoodCounter = 0;
+		uint32_t threadsDone = 0;
+		bool threadSpeculates = false;
+		vector<EvaluatedMove> rowMoves;
+
+		// Each thread own copy of current order.
+		uint32_t *threadStartTimesById = new uint32_t[project.numberOfActivities];
+		uint32_t *threadOrder = new uint32_t[project.numberOfActivities];
+		copy(instanceSolution.orderOfActivities, instanceSolution.orderOfActivities+project.numberOfActivities, threadOrder);
+
+		/* HUGE COMPUTING... */
+		#pragma omp for schedule(dynamic) nowait
+		for (uint32_t i = 1; i < project.numberOfActivities-1; ++i)	{
+			const vector<EvaluatedMove> *evaluatedMoves = &rowMoves;
+			if (reuseSpeculativeRows && trajectory.speculativeRowReady[i] == 1)	{
+				evaluatedMoves = &trajectory.speculativeRows[i];
+			} else if (sampling == false || trajectory.sampledRows[i] == 1)	{
+				evaluatedSchedulesInIteration += evaluateNeighbourhoodRow(project, instanceSolution, threadOrder, threadStartTimesById, i, algo, trajectory.swapRange,
+						trajectory.config->shiftRange, trajectory.config->scheduleGenerationScheme, cache, orderHash, cacheHitsInIteration, lowerBoundData, tabu, threadBestMove.cost, prunedMovesInIteration, criticalActivities, rowMoves);
+			} else {
+				continue;
+			}
 
-		if ((iter % 100) == 2)
-			algo = reqTimePerIterForCapacityResAlg < reqTimePerIterForTimeResAlg ? CAPACITY_RESOLUTION : TIME_RESOLUTION;
+			for (vector<EvaluatedMove>::const_iterator it = evaluatedMoves->begin(); it != evaluatedMoves->end(); ++it)	{
+				// The reused speculative rows contain all moves.
+				if (criticalActivities != NULL && criticalActivities[instanceSolution.orderOfActivities[it->i]] == 0
+						&& (it->type != SWAP || criticalActivities[instanceSolution.orderOfActivities[it->j]] == 0))
+					continue;
 
-		uint64_t evaluatedSchedulesInIteration = 0;
-		#pragma omp parallel reduction(+:neighborhoodSize,evaluatedSchedulesInIteration)
+				bool isPossibleMove = tabu->isPossibleMove(it->i, (it->type == SWAP ? it->j : it->i), it->type);
+				if ((isPossibleMove == true && threadBestMove.cost > it->cost) || it->cost < instanceSolution.costOfBestSchedule)	{
+					threadBestMove = *it;
+					++threadNeighborhoodCounter;
+				}
+			}
+		}
+
+		/* MERGE RESULTS */
+		#pragma omp critical
 		{
-			/* PRIVATE DATA FOR EVERY THREAD */
-			MoveType threadBestMove = NONE;
-			uint32_t threadBestI = 0, threadBestJ = 0, threadShiftDiff = 0;
-			uint32_t threadBestEval = UINT32_MAX;;
-			size_t threadNeighborhoodCounter = 0;
+			neighborhoodSize += threadNeighborhoodCounter;
+			if (threadNeighborhoodCounter > 0 && threadBestMove.cost < iterBestMove.cost)
+				iterBestMove = threadBestMove;
+
+			// The first idle thread selects the current best candidate for the speculation.
+			if (speculative && !speculationStarted && iterBestMove.type != NONE)	{
+				speculatedMove = iterBestMove;
+				speculativeSolution.orderOfActivities = trajectory.speculativeOrder;
+				copy(instanceSolution.orderOfActivities, instanceSolution.orderOfActivities+project.numberOfActivities, speculativeSolution.orderOfActivities);
+				speculativeOrderHash = orderHash;
+				applyMove(speculativeSolution.orderOfActivities, speculatedMove, speculativeOrderHash);
+				speculationStarted = true;
+			}
+			threadsDone = ++finishedThreads;
+			threadSpeculates = speculationStarted;
+		}
 
-			// Each thread own copy of current order.
-			InstanceSolution threadSolution = instanceSolution;
-			uint32_t *threadStartTimesById = new uint32_t[instance.numberOfActivities];
-			threadSolution.orderOfActivities = new uint32_t[instance.numberOfActivities];
-			copy(instanceSolution.orderOfActivities, instanceSolution.orderOfActivities+instance.numberOfActivities, threadSolution.orderOfActivities);
+		#ifdef _OPENMP
+		uint32_t numberOfThreads = omp_get_num_threads();
+		#else
+		uint32_t numberOfThreads = 1;
+		#endif
+
+		if (speculative == true)	{
+			if (threadsDone == numberOfThreads)	{
+				// The last thread applies the best move, other threads speculate meanwhile.
+				try {
+					finishSearchIteration(project, trajectory, iterBestMove, neighborhoodSize, graphFile);
+				} catch (exception& e)	{
+					iterationError = e.what();
+				}
+				#pragma omp atomic write
+				iterationFinished = true;
+			} else if (threadSpeculates == true)	{
+				// The neighbourhood of the candidate move is evaluated until the iteration is finished.
+				copy(speculativeSolution.orderOfActivities, speculativeSolution.orderOfActivities+project.numberOfActivities, threadOrder);
+				while (true)	{
+					bool finished;
+					#pragma omp atomic read
+					finished = iterationFinished;
+					if (finished == true)
+						break;
 
-			/* HUGE COMPUTING... */
-			#pragma omp for schedule(dynamic)
-			for (uint32_t i = 1; i < instance.numberOfActivities-1; ++i)	{
+					uint32_t i;
+					#pragma omp atomic capture
+					i = nextSpeculativeRow++;
+					if (i >= project.numberOfActivities-1)
+						break;
 
-				/* SWAP MOVES */
-				uint32_t u = min(i+1+ConfigureRCPSP::SWAP_RANGE, instance.numberOfActivities-1);
-				for (uint32_t j = i+1; j < u; ++j)	{
+					// The tabu list of the next iteration is not known, the speculative rows are not filtered.
+					evaluatedSchedulesInIteration += evaluateNeighbourhoodRow(project, speculativeSolution, threadOrder, threadStartTimesById, i, algo, trajectory.swapRange,
+							trajectory.config->shiftRange, trajectory.config->scheduleGenerationScheme, cache, speculativeOrderHash, cacheHitsInIteration, NULL, NULL, UINT32_MAX, prunedMovesInIteration, NULL, trajectory.nextSpeculativeRows[i]);
+					trajectory.nextSpeculativeRowReady[i] = 1;
+				}
+			}
+		}
 
-					// Check if current selected swap is precedence penalty free.
-					bool precedenceFree = checkSwapPrecedencePenalty(instance, instanceSolution, i, j);
+		delete[] threadStartTimesById;
+		delete[] threadOrder;
 
-					if (precedenceFree == true)	{
-						swap(threadSolution.orderOfActivities[i], threadSolution.orderOfActivities[j]);
+		// The pool threads are reused by other solvers, only the master thread stays bound until the end of the search.
+		#ifdef _OPENMP
+		if (omp_get_thread_num() != 0)
+			unbindTrajectoryThread(trajectory);
+		#endif
+	}
 
-						uint32_t totalMoveCost = forwardScheduleEvaluation(instance, threadSolution, threadStartTimesById, algo);
-						totalMoveCost += computeUpperBoundsOverhangPenalty(instance, instanceSolution, threadStartTimesById);
+	if ((iter % 100) == 0 || (iter % 100) == 1)	{
+		#ifdef __GNUC__
+		gettimeofday(&endTimeIter, NULL);
+		timersub(&endTimeIter, &startTimeIter, &diffTimeIter);
+		double iterRunTime = diffTimeIter.tv_sec+diffTimeIter.tv_usec/1000000.;
+		#elif defined _WIN32 || defined _WIN64 || defined WIN32 || defined WIN64
+		QueryPerformanceCounter(&stopTimeIterStamp);
+		double iterRunTime = (stopTimeIterStamp.QuadPart-startTimeIterStamp.QuadPart)/((double) ticksPerSecond.QuadPart);
+		#endif
+		if ((iter % 100) == 1)
+			trajectory.reqTimePerIterForTimeResAlg = iterRunTime;
+		else
+			trajectory.reqTimePerIterForCapacityResAlg = iterRunTime;
+	}
 
-						bool isPossibleMove = tabu->isPossibleMove(i, j, SWAP);
+	if (speculative == true)	{
+		if (!iterationError.empty())
+			throw runtime_error(iterationError);
+
+		// Speculative results are kept only if the speculated move won and the penalty base was not changed.
+		bool speculationValid = speculationStarted && trajectory.speculationValid;
+		speculationValid = speculationValid && speculatedMove.type == iterBestMove.type && speculatedMove.i == iterBestMove.i && speculatedMove.j == iterBestMove.j;
+		speculationValid = speculationValid && speculativeSolution.costOfBestSchedule == instanceSolution.costOfBestSchedule;
+		trajectory.speculationValid = speculationValid;
+		if (speculationValid == true)	{
+			swap(trajectory.speculativeRows, trajectory.nextSpeculativeRows);
+			swap(trajectory.speculativeRowReady, trajectory.nextSpeculativeRowReady);
+		}
+	} else {
+		finishSearchIteration(project, trajectory, iterBestMove, neighborhoodSize, graphFile);
+	}
 
-						if ((isPossibleMove == true && threadBestEval > totalMoveCost) || totalMoveCost < instanceSolution.costOfBestSchedule)	{
-							threadBestI = i; threadBestJ = j; threadBestMove = SWAP;
-							threadBestEval = totalMoveCost;
-							++threadNeighborhoodCounter;
-						}
-						++evaluatedSchedulesInIteration;
+	trajectory.tabu->goToNextIter(trajectory.randomState);
+	trajectory.numberOfEvaluatedSchedules += evaluatedSchedulesInIteration;
+	trajectory.numberOfCacheHits += cacheHitsInIteration;
+	trajectory.numberOfPrunedMoves += prunedMovesInIteration;
+	++trajectory.iteration;
+}
 
-						swap(threadSolution.orderOfActivities[i], threadSolution.orderOfActivities[j]);
-					} else if (instance.matrixOfSuccessors[instanceSolution.orderOfActivities[i]][instanceSolution.orderOfActivities[j]] == 1)	{
-						break;
-					}
+uint32_t ScheduleSolver::evaluateNeighbourhoodRow(const InstanceData& project, const InstanceSolution& solution, uint32_t *threadOrder, uint32_t *threadStartTimesById,
+		const uint32_t& i, EvaluationAlgorithm algo, const uint32_t& swapRange, const uint32_t& shiftRange, const ScheduleGenerationScheme& scheme,
+		EvaluationCache *cache, const uint64_t& orderHash, uint64_t& cacheHits,
+		const MoveLowerBoundData *lowerBoundData, const TabuList *tabu, const uint32_t& bestMoveCost, uint64_t& prunedMoves,
+		const uint8_t *criticalActivities, vector<EvaluatedMove>& moves)	{
+	InstanceSolution threadSolution = solution;
+	threadSolution.orderOfActivities = threadOrder;
+	uint64_t rowCacheHits = 0, rowPrunedMoves = 0;
+	bool criticalRow = (criticalActivities == NULL || criticalActivities[solution.orderOfActivities[i]] == 1);
+	moves.clear();
+
+	/* SWAP MOVES */
+	uint32_t u = min(i+1+swapRange, project.numberOfActivities-1);
+	for (uint32_t j = i+1; j < u; ++j)	{
+
+		// At least one of the swapped activities has to be critical.
+		if (criticalRow == false && criticalActivities[solution.orderOfActivities[j]] == 0)
+			continue;
+
+		// Check if current selected swap is precedence penalty free.
+		bool precedenceFree = checkSwapPrecedencePenalty(project, solution, i, j);
+
+		if (precedenceFree == true)	{
+			swap(threadSolution.orderOfActivities[i], threadSolution.orderOfActivities[j]);
+
+			if (lowerBoundData != NULL)	{
+				// The move can be selected only by the aspiration criterion or as the allowed move better than the best move of the thread.
+				uint32_t moveLowerBound = computeMoveLowerBound(project, solution, *lowerBoundData, threadSolution.orderOfActivities, i, j, threadStartTimesById);
+				if (moveLowerBound >= solution.costOfBestSchedule && (moveLowerBound >= bestMoveCost || tabu->isPossibleMove(i, j, SWAP) == false))	{
+					swap(threadSolution.orderOfActivities[i], threadSolution.orderOfActivities[j]);
+					++rowPrunedMoves;
+					continue;
 				}
+			}
 
-				/* SHIFT MOVES */
-				uint32_t minStartIdx = max(1, ((int32_t) i)-((int32_t) ConfigureRCPSP::SHIFT_RANGE));
-				uint32_t maxStartIdx = min(i+1+ConfigureRCPSP::SHIFT_RANGE, instance.numberOfActivities-1);
+			uint64_t moveHash = 0;
+			if (cache != NULL)	{
+				moveHash = EvaluationCache::changeHash(orderHash, solution.orderOfActivities, threadSolution.orderOfActivities, i);
+				moveHash = EvaluationCache::changeHash(moveHash, solution.orderOfActivities, threadSolution.orderOfActivities, j);
+			}
 
-				for (uint32_t shift = minStartIdx; shift < maxStartIdx; ++shift)	{
-					if (shift > i+1 || shift < i-1)	{
+			uint32_t totalMoveCost = evaluateMoveCost(project, solution, threadSolution, threadStartTimesById, algo, scheme, cache, moveHash, rowCacheHits);
 
-						bool penaltyFree = true;
-						if (shift > i+1)	{
-							for (uint32_t k = i+1; k < shift+1; ++k)	{
-								if (instance.matrixOfSuccessors[instanceSolution.orderOfActivities[i]][instanceSolution.orderOfActivities[k]] == 1)	{
-									penaltyFree = false;
-									shift = maxStartIdx;
-									break;
-								}
-							}
-						} else {
-							for (uint32_t k = shift; k < i; ++k)	{
-								if (instance.matrixOfSuccessors[instanceSolution.orderOfActivities[k]][instanceSolution.orderOfActivities[i]] == 1)	{
-									penaltyFree = false;
-									break;
-								}
-							}
-						}
+			EvaluatedMove move = { SWAP, i, j, totalMoveCost };
+			moves.push_back(move);
 
-						if (penaltyFree == true)	{
-							makeShift(threadSolution.orderOfActivities, ((int32_t) shift)-((int32_t) i), i);
+			swap(threadSolution.orderOfActivities[i], threadSolution.orderOfActivities[j]);
+		} else if (project.matrixOfSuccessors[solution.orderOfActivities[i]][solution.orderOfActivities[j]] == 1)	{
+			break;
+		}
+	}
 
-							uint32_t totalMoveCost = forwardScheduleEvaluation(instance, threadSolution, threadStartTimesById, algo);
-							totalMoveCost += computeUpperBoundsOverhangPenalty(instance, instanceSolution, threadStartTimesById);
-							bool isPossibleMove = tabu->isPossibleMove(i, i, SHIFT);
+	/* SHIFT MOVES */
+	uint32_t minStartIdx = max(1, ((int32_t) i)-((int32_t) shiftRange));
+	uint32_t maxStartIdx = (criticalRow == true ? min(i+1+shiftRange, project.numberOfActivities-1) : minStartIdx);
 
-							if ((isPossibleMove == true && threadBestEval > totalMoveCost) || totalMoveCost < instanceSolution.costOfBestSchedule)	{
-								threadBestI = threadBestJ = i; threadBestMove = SHIFT;
-								threadBestEval = totalMoveCost; threadShiftDiff = shift;
-								++threadNeighborhoodCounter;
-							}
-							++evaluatedSchedulesInIteration;
+	for (uint32_t shift = minStartIdx; shift < maxStartIdx; ++shift)	{
+		if (shift > i+1 || shift < i-1)	{
 
-							makeShift(threadSolution.orderOfActivities, ((int32_t) i)-((int32_t) shift), shift);
-						}
+			bool penaltyFree = true;
+			if (shift > i+1)	{
+				for (uint32_t k = i+1; k < shift+1; ++k)	{
+					if (project.matrixOfSuccessors[solution.orderOfActivities[i]][solution.orderOfActivities[k]] == 1)	{
+						penaltyFree = false;
+						shift = maxStartIdx;
+						break;
+					}
+				}
+			} else {
+				for (uint32_t k = shift; k < i; ++k)	{
+					if (project.matrixOfSuccessors[solution.orderOfActivities[k]][solution.orderOfActivities[i]] == 1)	{
+						penaltyFree = false;
+						break;
 					}
 				}
 			}
 
-			/* MERGE RESULTS */
-			if (threadNeighborhoodCounter > 0)	{
-				neighborhoodSize += threadNeighborhoodCounter;
-				#pragma omp critical
-				{
-					if (threadBestEval < iterBestEval)	{
-						iterBestI = threadBestI;
-						iterBestJ = threadBestJ;
-						iterBestMove = threadBestMove;
-						iterShiftDiff = threadShiftDiff;
-						iterBestEval = threadBestEval;
+			if (penaltyFree == true)	{
+				makeShift(threadSolution.orderOfActivities, ((int32_t) shift)-((int32_t) i), i);
+
+				if (lowerBoundData != NULL)	{
+					uint32_t moveLowerBound = computeMoveLowerBound(project, solution, *lowerBoundData, threadSolution.orderOfActivities, min(i, shift), max(i, shift), threadStartTimesById);
+					if (moveLowerBound >= solution.costOfBestSchedule && (moveLowerBound >= bestMoveCost || tabu->isPossibleMove(i, i, SHIFT) == false))	{
+						makeShift(threadSolution.orderOfActivities, ((int32_t) i)-((int32_t) shift), shift);
+						++rowPrunedMoves;
+						continue;
 					}
 				}
+
+				// All activities between the original and the target index are moved.
+				uint64_t moveHash = orderHash;
+				for (uint32_t k = min(i, shift); cache != NULL && k <= max(i, shift); ++k)
+					moveHash = EvaluationCache::changeHash(moveHash, solution.orderOfActivities, threadSolution.orderOfActivities, k);
+
+				uint32_t totalMoveCost = evaluateMoveCost(project, solution, threadSolution, threadStartTimesById, algo, scheme, cache, moveHash, rowCacheHits);
+
+				EvaluatedMove move = { SHIFT, i, shift, totalMoveCost };
+				moves.push_back(move);
+
+				makeShift(threadSolution.orderOfActivities, ((int32_t) i)-((int32_t) shift), shift);
+			}
+		}
+	}
+
+	cacheHits += rowCacheHits;
+	prunedMoves += rowPrunedMoves;
+	return moves.size()-rowCacheHits;
+}
+
+uint32_t ScheduleSolver::computeCriticalActivities(const InstanceData& project, const InstanceSolution& solution, EvaluationAlgorithm algo,
+		const ScheduleGenerationScheme& scheme, uint32_t *startTimesById, uint8_t * const& criticalActivities)	{
+	const uint32_t numberOfActivities = project.numberOfActivities;
+	const uint32_t * const durations = project.durationOfActivities;
+	uint32_t scheduleLength = decodeOrder(project, solution, startTimesById, algo, scheme);
+
+	// The activities sorted by the finish time, the candidates that finish at the given time are found by the binary search.
+	vector<pair<uint32_t, uint32_t> > activitiesByFinishTime(numberOfActivities);
+	for (uint32_t id = 0; id < numberOfActivities; ++id)
+		activitiesByFinishTime[id] = pair<uint32_t, uint32_t>(startTimesById[id]+durations[id], id);
+	sort(activitiesByFinishTime.begin(), activitiesByFinishTime.end());
+
+	// The resource loads just before the start times are computed by one sweep over the start and finish times.
+	// The requirement (an index to resourceRequirements) is binding if its resource lacked the capacity for the activity just before its start.
+	vector<pair<uint32_t, uint32_t> > activitiesByStartTime(numberOfActivities);
+	for (uint32_t id = 0; id < numberOfActivities; ++id)
+		activitiesByStartTime[id] = pair<uint32_t, uint32_t>(startTimesById[id], id);
+	sort(activitiesByStartTime.begin(), activitiesByStartTime.end());
+
+	vector<uint32_t> resourceLoads(project.numberOfResources, 0);
+	vector<uint8_t> bindingRequirements(project.requirementsOffsets[numberOfActivities], 0);
+	vector<pair<uint32_t, uint32_t> >::const_iterator started = activitiesByStartTime.begin(), finished = activitiesByFinishTime.begin();
+	for (vector<pair<uint32_t, uint32_t> >::const_iterator it = activitiesByStartTime.begin(); it != activitiesByStartTime.end(); ++it)	{
+		uint32_t startTime = it->first, activityId = it->second;
+		// The running activities started before the start time and they did not finish before it.
+		for (; started != activitiesByStartTime.end() && started->first < startTime; ++started)	{
+			for (uint32_t j = project.requirementsOffsets[started->second]; j < project.requirementsOffsets[started->second+1]; ++j)
+				resourceLoads[project.resourceRequirements[j].resourceId] += project.resourceRequirements[j].demand;
+		}
+		for (; finished != activitiesByFinishTime.end() && finished->first < startTime; ++finished)	{
+			for (uint32_t j = project.requirementsOffsets[finished->second]; j < project.requirementsOffsets[finished->second+1]; ++j)
+				resourceLoads[project.resourceRequirements[j].resourceId] -= project.resourceRequirements[j].demand;
+		}
+		for (uint32_t j = project.requirementsOffsets[activityId]; j < project.requirementsOffsets[activityId+1]; ++j)	{
+			const ResourceRequirement& requirement = project.resourceRequirements[j];
+			bindingRequirements[j] = (resourceLoads[requirement.resourceId]+requirement.demand > project.capacityOfResources[requirement.resourceId] ? 1 : 0);
+		}
+	}
+
+	vector<uint32_t> expandedActivities;
+	fill(criticalActivities, criticalActivities+numberOfActivities, 0);
+	for (uint32_t id = 0; id < numberOfActivities; ++id)	{
+		if (startTimesById[id]+durations[id] == scheduleLength)	{
+			criticalActivities[id] = 1;
+			expandedActivities.push_back(id);
+		}
+	}
+
+	uint32_t numberOfCriticalActivities = expandedActivities.size();
+	while (!expandedActivities.empty())	{
+		uint32_t activityId = expandedActivities.back();
+		expandedActivities.pop_back();
+
+		// The resource links are considered only if the activity was delayed by the resources.
+		uint32_t startTime = startTimesById[activityId], precedenceStartTime = 0;
+		for (uint32_t j = project.predecessorsOffsets[activityId]; j < project.predecessorsOffsets[activityId+1]; ++j)
+			precedenceStartTime = max(precedenceStartTime, startTimesById[project.predecessorIds[j]]+durations[project.predecessorIds[j]]);
+		bool delayedByResources = (precedenceStartTime < startTime);
+
+		// Only one link is followed, the chain either continues or it joins an already traced chain.
+		bool linked = false;
+		vector<pair<uint32_t, uint32_t> >::const_iterator it = lower_bound(activitiesByFinishTime.begin(), activitiesByFinishTime.end(), pair<uint32_t, uint32_t>(startTime, 0));
+		for (; it != activitiesByFinishTime.end() && it->first == startTime && !linked; ++it)	{
+			uint32_t candidateId = it->second;
+			if (candidateId == activityId)
+				continue;
+
+			linked = (delayedByResources == false && project.matrixOfSuccessors[candidateId][activityId] == 1);
+			for (uint32_t j = project.requirementsOffsets[activityId]; delayedByResources && !linked && j < project.requirementsOffsets[activityId+1]; ++j)	{
+				if (bindingRequirements[j] == 1 && project.requiredResourcesOfActivities[candidateId][project.resourceRequirements[j].resourceId] > 0)
+					linked = true;
 			}
 
-			delete[] threadStartTimesById;
-			delete[] threadSolution.orderOfActivities;
-		}
-
-		if ((iter % 100) == 0 || (iter % 100) == 1)	{
-			#ifdef __GNUC__
-			gettimeofday(&endTimeIter, NULL);
-			timersub(&endTimeIter, &startTimeIter, &diffTimeIter);
-			double iterRunTime = diffTimeIter.tv_sec+diffTimeIter.tv_usec/1000000.;
-			#elif defined _WIN32 || defined _WIN64 || defined WIN32 || defined WIN64
-			QueryPerformanceCounter(&stopTimeIterStamp);
-			double iterRunTime = (stopTimeIterStamp.QuadPart-startTimeIterStamp.QuadPart)/((double) ticksPerSecond.QuadPart);
-			#endif
-			if ((iter % 100) == 1)
-				reqTimePerIterForTimeResAlg = iterRunTime;
+			if (linked == true && criticalActivities[candidateId] == 0)	{
+				criticalActivities[candidateId] = 1;
+				expandedActivities.push_back(candidateId);
+				++numberOfCriticalActivities;
+			}
+		}
+	}
+
+	return numberOfCriticalActivities;
+}
+
+void ScheduleSolver::computeMoveLowerBoundData(const InstanceData& project, const InstanceSolution& solution, EvaluationAlgorithm algo, MoveLowerBoundData& lowerBoundData)	{
+	forwardScheduleEvaluation(project, solution, lowerBoundData.startTimesById, algo);
+
+	lowerBoundData.prefixMakespanBound[0] = lowerBoundData.prefixPenalty[0] = 0;
+	for (uint32_t position = 0; position < project.numberOfActivities; ++position)	{
+		uint32_t activityId = solution.orderOfActivities[position];
+		uint32_t finishBound = lowerBoundData.startTimesById[activityId]+project.durationOfActivities[activityId]+project.rightLeftLongestPaths[activityId];
+		lowerBoundData.positionOfActivity[activityId] = position;
+		lowerBoundData.prefixMakespanBound[position+1] = max(lowerBoundData.prefixMakespanBound[position], finishBound);
+		lowerBoundData.prefixPenalty[position+1] = lowerBoundData.prefixPenalty[position]+(finishBound+1 > solution.costOfBestSchedule ? finishBound+1-solution.costOfBestSchedule : 0);
+	}
+}
+
+uint32_t ScheduleSolver::computeMoveLowerBound(const InstanceData& project, const InstanceSolution& solution, const MoveLowerBoundData& lowerBoundData,
+		const uint32_t * const& moveOrder, const uint32_t& firstPosition, const uint32_t& lastPosition, uint32_t * const& lowerStartTimesById)	{
+	const uint32_t * const durations = project.durationOfActivities;
+	const uint32_t * const predecessorsOffsets = project.predecessorsOffsets;
+	const uint32_t * const predecessorIds = project.predecessorIds;
+
+	uint32_t makespanBound = lowerBoundData.prefixMakespanBound[firstPosition], penaltyBound = lowerBoundData.prefixPenalty[firstPosition];
+	for (uint32_t position = firstPosition; position <= lastPosition; ++position)	{
+		// The predecessors of the moved activity are either in the unchanged prefix or they were bounded before.
+		uint32_t activityId = moveOrder[position], start = 0;
+		for (uint32_t j = predecessorsOffsets[activityId]; j < predecessorsOffsets[activityId+1]; ++j)	{
+			uint32_t predecessorId = predecessorIds[j];
+			if (lowerBoundData.positionOfActivity[predecessorId] < firstPosition)
+				start = max(lowerBoundData.startTimesById[predecessorId]+durations[predecessorId], start);
 			else
-				reqTimePerIterForCapacityResAlg = iterRunTime;
+				start = max(lowerStartTimesById[predecessorId]+durations[predecessorId], start);
 		}
+		lowerStartTimesById[activityId] = start;
+
+		uint32_t finishBound = start+durations[activityId]+project.rightLeftLongestPaths[activityId];
+		makespanBound = max(makespanBound, finishBound);
+		if (finishBound+1 > solution.costOfBestSchedule)
+			penaltyBound += finishBound+1-solution.costOfBestSchedule;
+	}
 
-		/* CHECK BEST SOLUTION AND UPDATE TABU LIST */
+	return makespanBound+penaltyBound;
+}
 
-		if (neighborhoodSize > 0)	{
-			if ((iterBestMove == SWAP) && (tabu->isPossibleMove(iterBestI, iterBestJ, SWAP) == true))
-				tabu->addTurnToTabuList(iterBestI, iterBestJ, SWAP);
-			else if ((iterBestMove == SHIFT) && (tabu->isPossibleMove(iterBestI, iterBestI, SHIFT) == true))
-				tabu->addTurnToTabuList(iterBestI, iterBestI, SHIFT);
+uint32_t ScheduleSolver::evaluateMoveCost(const InstanceData& project, const InstanceSolution& solution, const InstanceSolution& moveSolution, uint32_t *threadStartTimesById,
+		EvaluationAlgorithm algo, const ScheduleGenerationScheme& scheme, EvaluationCache *cache, const uint64_t& moveHash, uint64_t& cacheHits)	{
+	uint32_t totalMoveCost = 0;
+	// The penalty depends on the best makespan and the evaluation algorithms may differ in the found schedule.
+	uint64_t key = (cache != NULL ? cache->evaluationKey(moveHash, solution.costOfBestSchedule, algo) : 0);
+	if (cache != NULL && cache->find(key, totalMoveCost))	{
+		++cacheHits;
+	} else {
+		totalMoveCost = decodeOrder(project, moveSolution, threadStartTimesById, algo, scheme);
+		totalMoveCost += computeUpperBoundsOverhangPenalty(project, solution, threadStartTimesById);
+		if (cache != NULL)
+			cache->insert(key, totalMoveCost);
+	}
+	return totalMoveCost;
+}
 
-			// Apply best move.
-			switch (iterBestMove)	{
-				case SWAP:
-					swap(instanceSolution.orderOfActivities[iterBestI], instanceSolution.orderOfActivities[iterBestJ]);
-					break;
-				case SHIFT:
-					makeShift(instanceSolution.orderOfActivities, ((int32_t) iterShiftDiff)-((int32_t) iterBestI), iterBestI);
-					break;
-				default:
-					throw runtime_error("ScheduleSolver::solveSchedule: Unsupported type of move!");
+void ScheduleSolver::finishSearchIteration(const InstanceData& project, SearchTrajectory& trajectory, const EvaluatedMove& iterBestMove, const size_t& neighborhoodSize, FILE *graphFile)	{
+	InstanceSolution& instanceSolution = trajectory.solution;
+	TabuList *tabu = trajectory.tabu;
+
+	/* CHECK BEST SOLUTION AND UPDATE TABU LIST */
+
+	if (neighborhoodSize > 0)	{
+		if ((iterBestMove.type == SWAP) && (tabu->isPossibleMove(iterBestMove.i, iterBestMove.j, SWAP) == true))
+			tabu->addTurnToTabuList(iterBestMove.i, iterBestMove.j, SWAP);
+		else if ((iterBestMove.type == SHIFT) && (tabu->isPossibleMove(iterBestMove.i, iterBestMove.i, SHIFT) == true))
+			tabu->addTurnToTabuList(iterBestMove.i, iterBestMove.i, SHIFT);
+
+		// Apply best move.
+		applyMove(instanceSolution.orderOfActivities, iterBestMove, trajectory.orderHash);
+
+		if (iterBestMove.cost < instanceSolution.costOfBestSchedule)	{
+			instanceSolution.costOfBestSchedule = iterBestMove.cost;
+			uint32_t *bestScheduleStartTimesById = new uint32_t[project.numberOfActivities];
+			if (trajectory.config->scheduleGenerationScheme != SERIAL_SGS)	{
+				// The serial scheme schedules the activities sorted by the start times no later than the decoded schedule.
+				decodeOrder(project, instanceSolution, bestScheduleStartTimesById, trajectory.algo, trajectory.config->scheduleGenerationScheme);
+				convertStartTimesById2ActivitiesOrder(project, instanceSolution, bestScheduleStartTimesById);
 			}
+			uint32_t shakedCost = shakingDownEvaluation(project, instanceSolution, bestScheduleStartTimesById);
+			if (shakedCost < instanceSolution.costOfBestSchedule)	{
+				convertStartTimesById2ActivitiesOrder(project, instanceSolution, bestScheduleStartTimesById);
+				instanceSolution.costOfBestSchedule = shakedCost;
+			}
+			copy(instanceSolution.orderOfActivities, instanceSolution.orderOfActivities+project.numberOfActivities, instanceSolution.bestScheduleOrder);
+			// The order may have been rearranged by the shaking down.
+			trajectory.orderHashValid = false;
+			tabu->bestSolutionFound();
+			trajectory.numberOfIterSinceBest = 0;
+			trajectory.prunedAfterCycle = false;
+			trajectory.timeOfBestSolution = getWallClockTime();
+			delete[] bestScheduleStartTimesById;
+		} else {
+			++trajectory.numberOfIterSinceBest;
+		}
 
-			if (iterBestEval < instanceSolution.costOfBestSchedule)	{
-				instanceSolution.costOfBestSchedule = iterBestEval;
-				uint32_t *bestScheduleStartTimesById = new uint32_t[instance.numberOfActivities];
-				uint32_t shakedCost = shakingDownEvaluation(instance, instanceSolution, bestScheduleStartTimesById);
-				if (shakedCost < instanceSolution.costOfBestSchedule)	{
-					convertStartTimesById2ActivitiesOrder(instance, instanceSolution, bestScheduleStartTimesById);
-					instanceSolution.costOfBestSchedule = shakedCost;
-				}
-				copy(instanceSolution.orderOfActivities, instanceSolution.orderOfActivities+instance.numberOfActivities, instanceSolution.bestScheduleOrder);
-				tabu->bestSolutionFound();
-				numberOfIterSinceBest = 0;
-				delete[] bestScheduleStartTimesById;
+		if (graphFile != NULL)	{
+			fprintf(graphFile, "%u; %u; %u;\n", trajectory.iteration+1u, iterBestMove.cost, instanceSolution.costOfBestSchedule);
+		}
+
+		bool cycleDetected = detectCycle(project, trajectory);
+		if (trajectory.numberOfIterSinceBest > trajectory.config->maximalNumberOfIterationsSinceBest)	{
+			makeDiversification(project, instanceSolution, trajectory.config->diversificationSwaps, trajectory.randomState);
+			trajectory.numberOfIterSinceBest = 0;
+			trajectory.prunedAfterCycle = false;
+			trajectory.recentOrderHashes.clear();
+			trajectory.speculationValid = false;
+			trajectory.orderHashValid = false;
+		} else if (cycleDetected == true && trajectory.numberOfIterSinceBest > 0)	{
+			// The search returned to a recent order, the pruned tabu list may break the cycle, else the diversification is called early.
+			++trajectory.numberOfDetectedCycles;
+			if (trajectory.prunedAfterCycle == false)	{
+				tabu->prune(trajectory.randomState);
+				trajectory.prunedAfterCycle = true;
 			} else {
-				++numberOfIterSinceBest;
+				trajectory.numberOfSavedIterations += trajectory.config->maximalNumberOfIterationsSinceBest+1-trajectory.numberOfIterSinceBest;
+				++trajectory.numberOfCycleDiversifications;
+				makeDiversification(project, instanceSolution, trajectory.config->diversificationSwaps, trajectory.randomState);
+				trajectory.numberOfIterSinceBest = 0;
+				trajectory.prunedAfterCycle = false;
+				trajectory.recentOrderHashes.clear();
+				trajectory.orderHashValid = false;
+			}
+			trajectory.speculationValid = false;
+		}
+	} else {
+		// The tabu list is full, clear some random tabu moves.
+		tabu->prune(trajectory.randomState);
+		trajectory.speculationValid = false;
+	}
+}
+
+void ScheduleSolver::applyMove(uint32_t * const& order, const EvaluatedMove& move, uint64_t& orderHash)	{
+	// The keys of the changed positions are removed from the hash before the move and added after it.
+	switch (move.type)	{
+		case SWAP:
+			orderHash = EvaluationCache::toggleKey(EvaluationCache::toggleKey(orderHash, order, move.i), order, move.j);
+			swap(order[move.i], order[move.j]);
+			orderHash = EvaluationCache::toggleKey(EvaluationCache::toggleKey(orderHash, order, move.i), order, move.j);
+			break;
+		case SHIFT:
+			for (uint32_t position = min(move.i, move.j); position <= max(move.i, move.j); ++position)
+				orderHash = EvaluationCache::toggleKey(orderHash, order, position);
+			makeShift(order, ((int32_t) move.j)-((int32_t) move.i), move.i);
+			for (uint32_t position = min(move.i, move.j); position <= max(move.i, move.j); ++position)
+				orderHash = EvaluationCache::toggleKey(orderHash, order, position);
+			break;
+		default:
+			throw runtime_error("ScheduleSolver::applyMove: Unsupported type of move!");
+	}
+}
+
+uint64_t ScheduleSolver::currentOrderHash(const InstanceData& project, SearchTrajectory& trajectory)	{
+	if (trajectory.orderHashValid == false)	{
+		trajectory.orderHash = EvaluationCache::hashOfOrder(trajectory.solution.orderOfActivities, project.numberOfActivities);
+		trajectory.orderHashValid = true;
+	}
+	return trajectory.orderHash;
+}
+
+void ScheduleSolver::solveScheduleIslands(const uint32_t& maxIter, const double& deadline)	{
+	#ifdef _OPENMP
+	// Each island evaluates its neighbourhood by a nested team of threads.
+	if (trajectories[0].numberOfThreads > 1)
+		omp_set_max_active_levels(2);
+	#endif
+
+	const uint32_t criticalPathMakespan = (uint32_t) instance.criticalPathMakespan;
+	bool timeExhausted = false;
+	for (uint32_t iter = 0; iter < maxIter && !timeExhausted && criticalPathMakespan < getBestTrajectory().solution.costOfBestSchedule; )	{
+		uint32_t epochLength = min(config.islandExchangeInterval, maxIter-iter);
+
+		#pragma omp parallel for num_threads(numberOfIslands) schedule(static,1)
+		for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+			SearchTrajectory& trajectory = trajectories[island];
+			bindTrajectoryThread(trajectory);
+			for (uint32_t epochIter = 0; epochIter < epochLength && criticalPathMakespan < trajectory.solution.costOfBestSchedule; ++epochIter)	{
+				if (getWallClockTime() >= deadline)	{
+					#pragma omp atomic write
+					timeExhausted = true;
+					break;
+				}
+				performSearchIteration(*trajectory.project, trajectory, NULL);
 			}
+			unbindTrajectoryThread(trajectory);
+		}
+
+		exchangeEliteSolutions();
+		iter += epochLength;
+	}
+}
 
-			if (graphFile != NULL)	{
-				fprintf(graphFile, "%u; %u; %u;\n", iter+1u, iterBestEval, instanceSolution.costOfBestSchedule);
+void ScheduleSolver::solveScheduleAsynchronously(const uint32_t& maxIter, const double& deadline)	{
+	#ifdef _OPENMP
+	if (trajectories[0].numberOfThreads > 1)
+		omp_set_max_active_levels(2);
+	#endif
+
+	// The best makespan found by any walker.
+	const uint32_t criticalPathMakespan = (uint32_t) instance.criticalPathMakespan;
+	atomic<uint32_t> bestCost(getBestTrajectory().solution.costOfBestSchedule);
+
+	#pragma omp parallel for num_threads(numberOfIslands) schedule(static,1)
+	for (uint32_t walker = 0; walker < numberOfIslands; ++walker)	{
+		SearchTrajectory& trajectory = trajectories[walker];
+		InstanceSolution& solution = trajectory.solution;
+		bindTrajectoryThread(trajectory);
+		elitePool->addSolution(solution.bestScheduleOrder, solution.costOfBestSchedule);
+
+		for (uint32_t iter = 0; iter < maxIter; ++iter)	{
+			uint32_t cost = bestCost.load(memory_order_relaxed);
+			if (cost <= criticalPathMakespan || getWallClockTime() >= deadline)
+				break;
+
+			uint32_t costBeforeIteration = solution.costOfBestSchedule;
+			performSearchIteration(*trajectory.project, trajectory, NULL);
+
+			if (solution.costOfBestSchedule < costBeforeIteration)	{
+				// Publish the improved makespan, the shared best is only lowered.
+				while (cost > solution.costOfBestSchedule && !bestCost.compare_exchange_weak(cost, solution.costOfBestSchedule, memory_order_relaxed))
+					;
+				elitePool->addSolution(solution.bestScheduleOrder, solution.costOfBestSchedule);
 			}
 
-			if (numberOfIterSinceBest > ConfigureRCPSP::MAXIMAL_NUMBER_OF_ITERATIONS_SINCE_BEST)	{
-				makeDiversification(instance, instanceSolution);
-				numberOfIterSinceBest = 0;
+			if ((iter+1) % config.islandExchangeInterval == 0)	{
+				// The elite pool is locked only if some other walker is better.
+				cost = bestCost.load(memory_order_relaxed);
+				uint32_t eliteCost = 0;
+				if (cost < solution.costOfBestSchedule && elitePool->copyRandomBetterSolution(solution.costOfBestSchedule, solution.bestScheduleOrder, eliteCost, generateRandomNumber(trajectory.randomState)))	{
+					copy(solution.bestScheduleOrder, solution.bestScheduleOrder+instance.numberOfActivities, solution.orderOfActivities);
+					solution.costOfBestSchedule = eliteCost;
+					trajectory.tabu->bestSolutionFound();
+					trajectory.numberOfIterSinceBest = 0;
+					trajectory.speculationValid = false;
+					trajectory.orderHashValid = false;
+					trajectory.timeOfBestSolution = getWallClockTime();
+				}
 			}
-		} else {
-			// The tabu list is full, clear some random tabu moves.
-			tabu->prune();
 		}
+		unbindTrajectoryThread(trajectory);
+	}
+}
+
+void ScheduleSolver::exchangeEliteSolutions()	{
+	for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+		const InstanceSolution& solution = trajectories[island].solution;
+		elitePool->addSolution(solution.bestScheduleOrder, solution.costOfBestSchedule);
+	}
+
+	for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+		SearchTrajectory& trajectory = trajectories[island];
+		const EliteSolution *elite = elitePool->getRandomBetterSolution(trajectory.solution.costOfBestSchedule, generateRandomNumber(trajectory.randomState));
+		if (elite != NULL)	{
+			// The island continues from the better elite order.
+			copy(elite->order, elite->order+instance.numberOfActivities, trajectory.solution.orderOfActivities);
+			copy(elite->order, elite->order+instance.numberOfActivities, trajectory.solution.bestScheduleOrder);
+			trajectory.solution.costOfBestSchedule = elite->cost;
+			trajectory.tabu->bestSolutionFound();
+			trajectory.numberOfIterSinceBest = 0;
+			trajectory.speculationValid = false;
+			trajectory.orderHashValid = false;
+			// The island that found the solution is preferred by getBestTrajectory.
+			trajectory.timeOfBestSolution = getWallClockTime();
+		}
+	}
+}
 
-		tabu->goToNextIter();
-		numberOfEvaluatedSchedules += evaluatedSchedulesInIteration;
+TabuList* ScheduleSolver::createTabuList(const InstanceData& project, const SolverConfig& config, const TabuType& type, const uint32_t& tabuListSize)	{
+	if (type == SIMPLE_TABU)
+		return new SimpleTabuList(project.numberOfActivities, tabuListSize);
+	else if (type == ADVANCED_TABU)
+		return new AdvancedTabuList(config);
+	else
+		throw invalid_argument("ScheduleSolver::createTabuList: Invalid type of tabu list!");
+}
+
+void ScheduleSolver::setPortfolioMember(const uint32_t& member, SearchTrajectory& trajectory)	{
+	// Tabu lists alternate, each pair of members has its own swap range and simple tabu list size.
+	trajectory.tabuType = ((member % 2) == 0 ? SIMPLE_TABU : ADVANCED_TABU);
+	switch ((member/2) % 3)	{
+		case 0:
+			trajectory.swapRange = trajectory.config->swapRange;
+			trajectory.tabuListSize = trajectory.config->simpleTabuListSize;
+			break;
+		case 1:
+			trajectory.swapRange = max(trajectory.config->swapRange/2, 1u);
+			trajectory.tabuListSize = max(trajectory.config->simpleTabuListSize/8, 1u);
+			break;
+		default:
+			trajectory.swapRange = 2*trajectory.config->swapRange;
+			trajectory.tabuListSize = 2*trajectory.config->simpleTabuListSize;
 	}
+}
 
-	if (graphFile != NULL)	{
-		fclose(graphFile);
+const ScheduleSolver::SearchTrajectory& ScheduleSolver::getBestTrajectory() const	{
+	uint32_t bestIsland = 0;
+	for (uint32_t island = 1; island < numberOfIslands; ++island)	{
+		const SearchTrajectory& trajectory = trajectories[island], & bestTrajectory = trajectories[bestIsland];
+		if (trajectory.solution.costOfBestSchedule < bestTrajectory.solution.costOfBestSchedule)
+			bestIsland = island;
+		else if (trajectory.solution.costOfBestSchedule == bestTrajectory.solution.costOfBestSchedule && trajectory.timeOfBestSolution < bestTrajectory.timeOfBestSolution)
+			bestIsland = island;
 	}
+	return trajectories[bestIsland];
+}
 
+double ScheduleSolver::getWallClockTime()	{
 	#ifdef __GNUC__
-	gettimeofday(&endTime, NULL);
-	timersub(&endTime, &startTime, &diffTime);
-	totalRunTime += diffTime.tv_sec+diffTime.tv_usec/1000000.;
+	timeval currentTime;
+	gettimeofday(&currentTime, NULL);
+	return currentTime.tv_sec+currentTime.tv_usec/1000000.;
 	#elif defined _WIN32 || defined _WIN64 || defined WIN32 || defined WIN64
-	QueryPerformanceCounter(&stopTimeStamp);
-	totalRunTime += (stopTimeStamp.QuadPart-startTimeStamp.QuadPart)/((double) ticksPerSecond.QuadPart);
+	LARGE_INTEGER ticksPerSecond, currentTimeStamp;
+	QueryPerformanceFrequency(&ticksPerSecond);
+	QueryPerformanceCounter(&currentTimeStamp);
+	return currentTimeStamp.QuadPart/((double) ticksPerSecond.QuadPart);
 	#endif
 }
 
+void ScheduleSolver::bindTrajectoryThread(SearchTrajectory& trajectory)	{
+	if (trajectory.numaTopology != NULL && trajectory.numaTopology->bindCurrentThread(trajectory.numaNode))	{
+		int32_t currentNode = trajectory.numaTopology->getCurrentNode();
+		if (currentNode >= 0)	{
+			#pragma omp atomic write
+			trajectory.usedNumaNode = trajectory.numaTopology->getNodeId(currentNode);
+		}
+	}
+}
+
+void ScheduleSolver::unbindTrajectoryThread(const SearchTrajectory& trajectory)	{
+	if (trajectory.numaTopology != NULL)
+		trajectory.numaTopology->unbindCurrentThread();
+}
+
+void ScheduleSolver::buildNumaReplica(const InstanceData *project, const NumaTopology *topology, uint32_t node, InstanceData **replica)	{
+	topology->bindCurrentThread(node);
+	*replica = createInstanceDataReplica(*project);
+}
+
+ScheduleSolver::InstanceData* ScheduleSolver::createInstanceDataReplica(const InstanceData& project)	{
+	InstanceData *replica = new InstanceData(project);
+
+	// The whole arena is copied at once, only the pointers have to be set again.
+	size_t arenaSize = mapInstanceArena(*replica, NULL);
+	replica->instanceArena = new uint8_t[arenaSize+INSTANCE_ARENA_ALIGNMENT];
+	uint8_t *arena = alignInstanceArena(replica->instanceArena);
+	memcpy(arena, alignInstanceArena(project.instanceArena), arenaSize);
+	mapInstanceArena(*replica, arena);
+	createArenaRowPointers(*replica);
+
+	replica->rightLeftLongestPaths = new uint32_t[project.numberOfActivities];
+	copy(project.rightLeftLongestPaths, project.rightLeftLongestPaths+project.numberOfActivities, replica->rightLeftLongestPaths);
+
+	return replica;
+}
+
+void ScheduleSolver::destroyInstanceDataReplica(InstanceData *replica)	{
+	if (replica == NULL)
+		return;
+
+	freeInstanceArena(*replica);
+	delete[] replica->rightLeftLongestPaths;
+	// The caches of all successors and predecessors are shared with the original instance data.
+	delete replica;
+}
+
+uint64_t ScheduleSolver::getNumberOfEvaluatedSchedules() const	{
+	uint64_t numberOfEvaluatedSchedules = 0;
+	for (uint32_t island = 0; island < numberOfIslands; ++island)
+		numberOfEvaluatedSchedules += trajectories[island].numberOfEvaluatedSchedules;
+	return numberOfEvaluatedSchedules;
+}
+
+uint32_t ScheduleSolver::generateRandomNumber(uint32_t& state)	{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
 void ScheduleSolver::printBestSchedule(bool verbose, ostream& output)	{
-	swap(instanceSolution.orderOfActivities, instanceSolution.bestScheduleOrder);
-	printSchedule(instance, instanceSolution, totalRunTime, numberOfEvaluatedSchedules,  verbose, output);
-	swap(instanceSolution.orderOfActivities, instanceSolution.bestScheduleOrder);
+	uint64_t numberOfEvaluatedSchedules = getNumberOfEvaluatedSchedules();
+
+	const SearchTrajectory& bestTrajectory = getBestTrajectory();
+	InstanceSolution bestSolution = bestTrajectory.solution;
+	swap(bestSolution.orderOfActivities, bestSolution.bestScheduleOrder);
+	printSchedule(instance, bestSolution, totalRunTime, timeToBest, numberOfEvaluatedSchedules,  verbose, output);
+
+	if (config.renumberActivities == true && verbose == true)	{
+		output<<"Activities renumbered: ";
+		if (instance.originalIdOfActivity.empty() && instance.numberOfActivities > 1)
+			output<<"no (the level order does not keep the dummy activities at the ends)"<<endl;
+		else
+			output<<"yes"<<endl;
+	}
+
+	if (evaluationCache != NULL && verbose == true)	{
+		uint64_t numberOfCacheHits = 0;
+		for (uint32_t island = 0; island < numberOfIslands; ++island)
+			numberOfCacheHits += trajectories[island].numberOfCacheHits;
+		uint64_t numberOfLookups = numberOfCacheHits+numberOfEvaluatedSchedules;
+		output<<"Evaluation cache hit rate: "<<(numberOfLookups > 0 ? (100.0*numberOfCacheHits)/numberOfLookups : 0.0)<<" %";
+		output<<" ("<<numberOfCacheHits<<" of "<<numberOfLookups<<" moves)"<<endl;
+	}
+
+	if (config.criticalNeighbourhood == true && verbose == true)	{
+		uint64_t numberOfRestrictedIterations = 0, numberOfCriticalActivities = 0, numberOfIterations = 0;
+		for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+			numberOfRestrictedIterations += trajectories[island].numberOfRestrictedIterations;
+			numberOfCriticalActivities += trajectories[island].numberOfCriticalActivities;
+			numberOfIterations += trajectories[island].iteration;
+		}
+		output<<"Critical neighbourhood iterations: "<<numberOfRestrictedIterations<<" of "<<numberOfIterations;
+		if (numberOfRestrictedIterations > 0)
+			output<<" (critical activities "<<(100.0*numberOfCriticalActivities)/(numberOfRestrictedIterations*instance.numberOfActivities)<<" % on average)";
+		output<<endl;
+	}
+
+	if (config.lowerBoundFilter == true && verbose == true)	{
+		uint64_t numberOfPrunedMoves = 0, numberOfCacheHits = 0;
+		for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+			numberOfPrunedMoves += trajectories[island].numberOfPrunedMoves;
+			numberOfCacheHits += trajectories[island].numberOfCacheHits;
+		}
+		uint64_t numberOfMoves = numberOfPrunedMoves+numberOfCacheHits+numberOfEvaluatedSchedules;
+		output<<"Lower bound filter pruning ratio: "<<(numberOfMoves > 0 ? (100.0*numberOfPrunedMoves)/numberOfMoves : 0.0)<<" %";
+		output<<" ("<<numberOfPrunedMoves<<" of "<<numberOfMoves<<" moves)"<<endl;
+	}
+
+	if (config.cycleDetectionHistory > 0 && verbose == true)	{
+		uint64_t numberOfDetectedCycles = 0, numberOfCycleDiversifications = 0, numberOfSavedIterations = 0;
+		for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+			numberOfDetectedCycles += trajectories[island].numberOfDetectedCycles;
+			numberOfCycleDiversifications += trajectories[island].numberOfCycleDiversifications;
+			numberOfSavedIterations += trajectories[island].numberOfSavedIterations;
+		}
+		output<<"Detected search cycles: "<<numberOfDetectedCycles<<" ("<<numberOfCycleDiversifications<<" early diversifications, ";
+		output<<numberOfSavedIterations<<" iterations without improvement saved)"<<endl;
+	}
+
+	if (config.portfolioMode == true && verbose == true)	{
+		output<<"Best portfolio member: "<<(&bestTrajectory-trajectories)<<" (";
+		if (bestTrajectory.tabuType == SIMPLE_TABU)
+			output<<"simple tabu list of size "<<bestTrajectory.tabuListSize;
+		else
+			output<<"advanced tabu list";
+		output<<", swap range "<<bestTrajectory.swapRange<<")"<<endl;
+	}
+
+	if (numaTopology != NULL && verbose == true)	{
+		output<<"NUMA nodes of the islands:";
+		for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+			output<<" "<<island<<"->";
+			if (trajectories[island].usedNumaNode >= 0)
+				output<<trajectories[island].usedNumaNode;
+			else
+				output<<"?";
+		}
+		output<<" ("<<numaTopology->getNumberOfNodes()<<" nodes detected)"<<endl;
+	}
 }
 
 void ScheduleSolver::writeBestScheduleToFile(const string& fileName) {
@@ -334,101 +1248,349 @@ void ScheduleSolver::writeBestScheduleToFile(const string& fileName) {
 	if (!out)
 		throw invalid_argument("ScheduleSolver::writeBestScheduleToFile: Cannot open the output file to write!");
 
-	writeBestScheduleToFile(out, instance, instanceSolution).close();
+	writeBestScheduleToFile(out, instance, getBestTrajectory().solution).close();
+}
+
+uint32_t ScheduleSolver::getBestSchedule(vector<uint32_t>& startTimes) const	{
+	InstanceSolution bestSolution = getBestTrajectory().solution;
+	swap(bestSolution.orderOfActivities, bestSolution.bestScheduleOrder);
+
+	uint32_t *startTimesById = new uint32_t[instance.numberOfActivities];
+	uint32_t scheduleLength = shakingDownEvaluation(instance, bestSolution, startTimesById);
+	startTimes.resize(instance.numberOfActivities);
+	for (uint32_t id = 0; id < instance.numberOfActivities; ++id)
+		startTimes[originalActivityId(instance, id)] = startTimesById[id];
+	delete[] startTimesById;
+
+	return scheduleLength;
 }
 
 ScheduleSolver::~ScheduleSolver()	{
 	for (uint32_t i = 0; i < instance.numberOfActivities; ++i)	{
-		delete[] instance.predecessorsOfActivity[i];
-		delete[] instance.matrixOfSuccessors[i];
 		delete instance.allSuccessorsCache[i];
 		delete instance.allPredecessorsCache[i];
 	}
 
-	delete[] instance.numberOfPredecessors;
-	delete[] instance.predecessorsOfActivity;
-	delete[] instance.matrixOfSuccessors;
+	freeInstanceArena(instance);
 	delete[] instance.rightLeftLongestPaths;
 
-	delete[] instanceSolution.orderOfActivities;
-	delete[] instanceSolution.bestScheduleOrder;
+	for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+		delete[] trajectories[island].solution.orderOfActivities;
+		delete[] trajectories[island].solution.bestScheduleOrder;
+		delete trajectories[island].tabu;
+		delete[] trajectories[island].speculativeOrder;
+		delete[] trajectories[island].lowerBoundData.startTimesById;
+		delete[] trajectories[island].lowerBoundData.positionOfActivity;
+		delete[] trajectories[island].lowerBoundData.prefixMakespanBound;
+		delete[] trajectories[island].lowerBoundData.prefixPenalty;
+		delete[] trajectories[island].criticalActivities;
+		delete[] trajectories[island].criticalStartTimesById;
+	}
+
+	delete[] trajectories;
+	delete elitePool;
 
-	delete tabu;
+	for (vector<InstanceData*>::iterator it = numaReplicas.begin(); it != numaReplicas.end(); ++it)
+		destroyInstanceDataReplica(*it);
+	delete numaTopology;
+	delete evaluationCache;
 }
 
-void ScheduleSolver::initialiseInstanceDataAndInitialSolution(InstanceData& project, InstanceSolution& solution)	{
-	// It computes the estimate of the longest duration of the project.
-	project.upperBoundMakespan = accumulate(project.durationOfActivities, project.durationOfActivities+project.numberOfActivities, 0);
+void ScheduleSolver::initialiseInstanceArena(InstanceData& project, const InputReader& rcpspData, const bool& renumberActivities)	{
+	project.numberOfResources = rcpspData.getNumberOfResources();
+	project.numberOfActivities = rcpspData.getNumberOfActivities();
+	project.originalIdOfActivity.clear();
+	project.internalIdOfActivity.clear();
+
+	const uint32_t numberOfActivities = project.numberOfActivities;
+	uint32_t **successors = rcpspData.getActivitiesSuccessors(), *numberOfSuccessors = rcpspData.getActivitiesNumberOfSuccessors();
+	if (renumberActivities == true && numberOfActivities > 1)	{
+		// The activities are relabelled in the order of the initial solution, i.e. by levels of the precedence graph.
+		InstanceData readProject = project;
+		readProject.numberOfSuccessors = numberOfSuccessors;
+		readProject.successorsOfActivity = successors;
+		InstanceSolution levelOrder;
+		createInitialSolution(readProject, levelOrder);
+		// The dummy start and end activities have to keep their ids.
+		if (levelOrder.orderOfActivities[0] == 0 && levelOrder.orderOfActivities[numberOfActivities-1] == numberOfActivities-1)
+			project.originalIdOfActivity.assign(levelOrder.orderOfActivities, levelOrder.orderOfActivities+numberOfActivities);
+		delete[] levelOrder.orderOfActivities;
+	}
+
+	if (project.originalIdOfActivity.empty())	{
+		createInstanceArena(project, rcpspData.getActivitiesDuration(), rcpspData.getCapacityOfResources(),
+				successors, numberOfSuccessors, rcpspData.getActivitiesResources());
+	} else {
+		vector<uint32_t>& newIdOfActivity = project.internalIdOfActivity;
+		newIdOfActivity.resize(numberOfActivities);
+		for (uint32_t newId = 0; newId < numberOfActivities; ++newId)
+			newIdOfActivity[project.originalIdOfActivity[newId]] = newId;
+
+		// The read arrays are permuted to the new ids.
+		vector<uint32_t> durations(numberOfActivities), successorsCounts(numberOfActivities), successorsStorage;
+		vector<const uint32_t*> successorsRows(numberOfActivities), requirementsRows(numberOfActivities);
+		vector<uint32_t> successorsRowOffsets(numberOfActivities);
+		for (uint32_t newId = 0; newId < numberOfActivities; ++newId)	{
+			uint32_t originalId = project.originalIdOfActivity[newId];
+			durations[newId] = rcpspData.getActivitiesDuration()[originalId];
+			requirementsRows[newId] = rcpspData.getActivitiesResources()[originalId];
+			successorsCounts[newId] = numberOfSuccessors[originalId];
+			successorsRowOffsets[newId] = successorsStorage.size();
+			for (uint32_t s = 0; s < numberOfSuccessors[originalId]; ++s)
+				successorsStorage.push_back(newIdOfActivity[successors[originalId][s]]);
+		}
+		for (uint32_t newId = 0; newId < numberOfActivities; ++newId)
+			successorsRows[newId] = successorsStorage.empty() ? NULL : &successorsStorage[successorsRowOffsets[newId]];
 
-	/* PRECOMPUTE ACTIVITIES PREDECESSORS */
+		createInstanceArena(project, &durations[0], rcpspData.getCapacityOfResources(), &successorsRows[0], &successorsCounts[0], &requirementsRows[0]);
+	}
+}
 
-	project.predecessorsOfActivity = new uint32_t*[project.numberOfActivities];
-	project.numberOfPredecessors = new uint32_t[project.numberOfActivities];
-	memset(project.numberOfPredecessors, 0, sizeof(uint32_t)*project.numberOfActivities);
+uint32_t ScheduleSolver::originalActivityId(const InstanceData& project, const uint32_t& activityId)	{
+	return project.originalIdOfActivity.empty() ? activityId : project.originalIdOfActivity[activityId];
+}
 
-	for (uint32_t activityId = 0; activityId < project.numberOfActivities; ++activityId)	{
-		for (uint32_t successorIdx = 0; successorIdx < project.numberOfSuccessors[activityId]; ++successorIdx)	{
-			uint32_t successorId = project.successorsOfActivity[activityId][successorIdx];
-			++project.numberOfPredecessors[successorId];
+uint32_t ScheduleSolver::internalActivityId(const InstanceData& project, const uint32_t& activityId, const string& method)	{
+	if (activityId >= project.numberOfActivities)
+		throw invalid_argument("ScheduleSolver::"+method+": Invalid activity id!");
+	if (project.originalIdOfActivity.empty())
+		return activityId;
+	return project.internalIdOfActivity[activityId];
+}
+
+void ScheduleSolver::createInstanceArena(InstanceData& project, const uint32_t * const& durations, const uint32_t * const& capacities,
+		const uint32_t * const * const& successors, const uint32_t * const& numberOfSuccessors, const uint32_t * const * const& requirements)	{
+	const uint32_t numberOfActivities = project.numberOfActivities, numberOfResources = project.numberOfResources;
+	project.numberOfEdges = accumulate(numberOfSuccessors, numberOfSuccessors+numberOfActivities, 0u);
+	project.numberOfRequirements = 0;
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)
+		project.numberOfRequirements += numberOfResources-count(requirements[activityId], requirements[activityId]+numberOfResources, 0u);
+
+	size_t arenaSize = mapInstanceArena(project, NULL);
+	project.instanceArena = new uint8_t[arenaSize+INSTANCE_ARENA_ALIGNMENT];
+	uint8_t *arena = alignInstanceArena(project.instanceArena);
+	memset(arena, 0, arenaSize);
+	mapInstanceArena(project, arena);
+
+	copy(durations, durations+numberOfActivities, project.durationOfActivities);
+	copy(capacities, capacities+numberOfResources, project.capacityOfResources);
+	copy(numberOfSuccessors, numberOfSuccessors+numberOfActivities, project.numberOfSuccessors);
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)
+		copy(requirements[activityId], requirements[activityId]+numberOfResources, project.requirementsMatrix+activityId*numberOfResources);
+
+	/* NON-ZERO RESOURCE REQUIREMENTS IN THE CSR FORMAT */
+
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
+		uint32_t requirementIdx = project.requirementsOffsets[activityId];
+		for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
+			if (requirements[activityId][resourceId] > 0)	{
+				project.resourceRequirements[requirementIdx].resourceId = resourceId;
+				project.resourceRequirements[requirementIdx].demand = requirements[activityId][resourceId];
+				++requirementIdx;
+			}
 		}
+		project.requirementsOffsets[activityId+1] = requirementIdx;
 	}
 
-	for (uint32_t activityId = 0; activityId < project.numberOfActivities; ++activityId)	{
-		project.predecessorsOfActivity[activityId] = new uint32_t[project.numberOfPredecessors[activityId]];
+	/* SUCCESSORS AND PREDECESSORS IN THE CSR FORMAT */
+
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
+		project.successorsOffsets[activityId+1] = project.successorsOffsets[activityId]+numberOfSuccessors[activityId];
+		copy(successors[activityId], successors[activityId]+numberOfSuccessors[activityId], project.successorIds+project.successorsOffsets[activityId]);
+		for (uint32_t s = 0; s < numberOfSuccessors[activityId]; ++s)
+			++project.numberOfPredecessors[successors[activityId][s]];
 	}
 
-	for (uint32_t activityId = 0; activityId < project.numberOfActivities; ++activityId)	{
-		for (uint32_t successorIdx = 0; successorIdx < project.numberOfSuccessors[activityId]; ++successorIdx)	{
-			uint32_t successorId = project.successorsOfActivity[activityId][successorIdx];
-			*(project.predecessorsOfActivity[successorId]) = activityId;	
-			++project.predecessorsOfActivity[successorId];
-		}
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)
+		project.predecessorsOffsets[activityId+1] = project.predecessorsOffsets[activityId]+project.numberOfPredecessors[activityId];
+
+	// Predecessors of each activity are sorted by id.
+	uint32_t *insertPosition = new uint32_t[numberOfActivities];
+	copy(project.predecessorsOffsets, project.predecessorsOffsets+numberOfActivities, insertPosition);
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
+		for (uint32_t s = 0; s < numberOfSuccessors[activityId]; ++s)
+			project.predecessorIds[insertPosition[successors[activityId][s]]++] = activityId;
 	}
+	delete[] insertPosition;
 
-	for (uint32_t activityId = 0; activityId < project.numberOfActivities; ++activityId)	{
-		project.predecessorsOfActivity[activityId] -= project.numberOfPredecessors[activityId];
+	/* MATRIX OF SUCCESSORS */
+
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
+		for (uint32_t s = 0; s < numberOfSuccessors[activityId]; ++s)
+			project.successorsMatrix[activityId*numberOfActivities+successors[activityId][s]] = 1;
 	}
 
-	/* CREATE INIT ORDER OF ACTIVITIES */
+	createArenaRowPointers(project);
+}
 
-	createInitialSolution(project, solution);
+size_t ScheduleSolver::mapInstanceArena(InstanceData& project, uint8_t *arena)	{
+	const size_t numberOfActivities = project.numberOfActivities, numberOfResources = project.numberOfResources;
+	size_t offset = 0;
+
+	// Each section starts at the cache line, the items of the hot evaluation loop are at the beginning.
+	project.durationOfActivities = (uint32_t*) arenaSection(arena, offset, sizeof(uint32_t)*numberOfActivities);
+	project.predecessorsOffsets = (uint32_t*) arenaSection(arena, offset, sizeof(uint32_t)*(numberOfActivities+1));
+	project.predecessorIds = (uint32_t*) arenaSection(arena, offset, sizeof(uint32_t)*project.numberOfEdges);
+	project.requirementsOffsets = (uint32_t*) arenaSection(arena, offset, sizeof(uint32_t)*(numberOfActivities+1));
+	project.resourceRequirements = (ResourceRequirement*) arenaSection(arena, offset, sizeof(ResourceRequirement)*project.numberOfRequirements);
+	project.requirementsMatrix = (uint32_t*) arenaSection(arena, offset, sizeof(uint32_t)*numberOfActivities*numberOfResources);
+	project.capacityOfResources = (uint32_t*) arenaSection(arena, offset, sizeof(uint32_t)*numberOfResources);
+	project.successorsOffsets = (uint32_t*) arenaSection(arena, offset, sizeof(uint32_t)*(numberOfActivities+1));
+	project.successorIds = (uint32_t*) arenaSection(arena, offset, sizeof(uint32_t)*project.numberOfEdges);
+	project.numberOfSuccessors = (uint32_t*) arenaSection(arena, offset, sizeof(uint32_t)*numberOfActivities);
+	project.numberOfPredecessors = (uint32_t*) arenaSection(arena, offset, sizeof(uint32_t)*numberOfActivities);
+	project.successorsMatrix = (int8_t*) arenaSection(arena, offset, sizeof(int8_t)*numberOfActivities*numberOfActivities);
+
+	return offset;
+}
+
+uint8_t* ScheduleSolver::arenaSection(uint8_t *arena, size_t& offset, const size_t& sizeOfSection)	{
+	uint8_t *section = (arena != NULL ? arena+offset : NULL);
+	offset += ((sizeOfSection+INSTANCE_ARENA_ALIGNMENT-1)/INSTANCE_ARENA_ALIGNMENT)*INSTANCE_ARENA_ALIGNMENT;
+	return section;
+}
 
-	/* PRECOMPUTE MATRIX OF SUCCESSORS */
+uint8_t* ScheduleSolver::alignInstanceArena(uint8_t *arenaMemory)	{
+	size_t misalignment = ((size_t) arenaMemory) % INSTANCE_ARENA_ALIGNMENT;
+	return (misalignment == 0 ? arenaMemory : arenaMemory+INSTANCE_ARENA_ALIGNMENT-misalignment);
+}
 
-	project.matrixOfSuccessors = new int8_t*[project.numberOfActivities];
-	for (uint32_t i = 0; i < project.numberOfActivities; ++i)	{
-		project.matrixOfSuccessors[i] = new int8_t[project.numberOfActivities];
-		memset(project.matrixOfSuccessors[i], 0, sizeof(int8_t)*project.numberOfActivities);
+void ScheduleSolver::createArenaRowPointers(InstanceData& project)	{
+	const uint32_t numberOfActivities = project.numberOfActivities;
+	project.successorsOfActivity = new uint32_t*[numberOfActivities];
+	project.predecessorsOfActivity = new uint32_t*[numberOfActivities];
+	project.requiredResourcesOfActivities = new uint32_t*[numberOfActivities];
+	project.matrixOfSuccessors = new int8_t*[numberOfActivities];
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
+		project.successorsOfActivity[activityId] = project.successorIds+project.successorsOffsets[activityId];
+		project.predecessorsOfActivity[activityId] = project.predecessorIds+project.predecessorsOffsets[activityId];
+		project.requiredResourcesOfActivities[activityId] = project.requirementsMatrix+activityId*project.numberOfResources;
+		project.matrixOfSuccessors[activityId] = project.successorsMatrix+activityId*numberOfActivities;
 	}
+}
 
-	for (uint32_t activityId = 0; activityId < project.numberOfActivities; ++activityId)	{
-		for (uint32_t j = 0; j < project.numberOfSuccessors[activityId]; ++j)	{
-			project.matrixOfSuccessors[activityId][project.successorsOfActivity[activityId][j]] = 1;
+void ScheduleSolver::freeInstanceArena(InstanceData& project)	{
+	delete[] project.successorsOfActivity;
+	delete[] project.predecessorsOfActivity;
+	delete[] project.requiredResourcesOfActivities;
+	delete[] project.matrixOfSuccessors;
+	delete[] project.instanceArena;
+}
+
+void ScheduleSolver::rebuildInstanceArena(InstanceData& project, const vector<vector<uint32_t> >& successors)	{
+	const uint32_t numberOfActivities = project.numberOfActivities, numberOfResources = project.numberOfResources;
+	vector<uint32_t> durations(project.durationOfActivities, project.durationOfActivities+numberOfActivities);
+	vector<uint32_t> capacities(project.capacityOfResources, project.capacityOfResources+numberOfResources);
+	vector<uint32_t> requirements(project.requirementsMatrix, project.requirementsMatrix+numberOfActivities*numberOfResources);
+	vector<uint32_t> successorsCounts(numberOfActivities);
+	vector<const uint32_t*> successorsRows(numberOfActivities), requirementsRows(numberOfActivities);
+	for (uint32_t activityId = 0; activityId < numberOfActivities; ++activityId)	{
+		successorsCounts[activityId] = successors[activityId].size();
+		successorsRows[activityId] = successors[activityId].data();
+		requirementsRows[activityId] = requirements.data()+activityId*numberOfResources;
+	}
+
+	freeInstanceArena(project);
+	createInstanceArena(project, durations.data(), capacities.data(), successorsRows.data(), successorsCounts.data(), requirementsRows.data());
+}
+
+vector<vector<uint32_t> > ScheduleSolver::getSuccessorLists(const InstanceData& project)	{
+	vector<vector<uint32_t> > successors(project.numberOfActivities);
+	for (uint32_t activityId = 0; activityId < project.numberOfActivities; ++activityId)
+		successors[activityId].assign(project.successorsOfActivity[activityId], project.successorsOfActivity[activityId]+project.numberOfSuccessors[activityId]);
+	return successors;
+}
+
+void ScheduleSolver::updateTransitiveCaches(InstanceData& project, const vector<bool>& successorsOutdated, const vector<bool>& predecessorsOutdated)	{
+	const uint32_t numberOfActivities = project.numberOfActivities;
+	// The equal priorities give a topological order, the lowest eligible id is always selected.
+	vector<uint32_t> equalPriorities(numberOfActivities, 0), topologicalOrder(numberOfActivities);
+	createPriorityList(project, equalPriorities.data(), NULL, topologicalOrder.data());
+
+	vector<bool> relatedActivities(numberOfActivities);
+	for (uint32_t position = 0; position < numberOfActivities; ++position)	{
+		// The successors are updated from the end of the order, the predecessors from the beginning.
+		for (uint32_t direction = 0; direction < 2; ++direction)	{
+			uint32_t activityId = (direction == 0 ? topologicalOrder[numberOfActivities-position-1] : topologicalOrder[position]);
+			if ((direction == 0 && successorsOutdated[activityId] == false) || (direction == 1 && predecessorsOutdated[activityId] == false))
+				continue;
+
+			uint32_t numberOfRelated = (direction == 0 ? project.numberOfSuccessors[activityId] : project.numberOfPredecessors[activityId]);
+			const uint32_t *related = (direction == 0 ? project.successorsOfActivity[activityId] : project.predecessorsOfActivity[activityId]);
+			const vector<vector<uint32_t>*>& cache = (direction == 0 ? project.allSuccessorsCache : project.allPredecessorsCache);
+			fill(relatedActivities.begin(), relatedActivities.end(), false);
+			for (uint32_t r = 0; r < numberOfRelated; ++r)	{
+				relatedActivities[related[r]] = true;
+				for (vector<uint32_t>::const_iterator it = cache[related[r]]->begin(); it != cache[related[r]]->end(); ++it)
+					relatedActivities[*it] = true;
+			}
+
+			vector<uint32_t>& allRelated = *cache[activityId];
+			allRelated.clear();
+			for (uint32_t id = 0; id < numberOfActivities; ++id)	{
+				if (relatedActivities[id] == true)
+					allRelated.push_back(id);
+			}
 		}
 	}
+}
+
+void ScheduleSolver::computeInstanceBounds(InstanceData& project)	{
+	selectValueTypes(project);
+	computeCriticalPathMakespan(project);
+	computeRightLeftLongestPaths(project);
+}
+
+void ScheduleSolver::selectValueTypes(InstanceData& project)	{
+	// It computes the estimate of the longest duration of the project.
+	project.upperBoundMakespan = accumulate(project.durationOfActivities, project.durationOfActivities+project.numberOfActivities, 0);
+	// The evaluators store the narrowest values that fit the instance to reduce the memory traffic.
+	project.timeValueBytes = narrowestIntegerBytes(project.upperBoundMakespan);
+	project.capacityValueBytes = narrowestIntegerBytes(*max_element(project.capacityOfResources, project.capacityOfResources+project.numberOfResources));
+	selectEvaluationKernels(project);
+}
 
-	/* IT COMPUTES THE CRITICAL PATH LENGTH */
+void ScheduleSolver::computeCriticalPathMakespan(InstanceData& project)	{
 	uint32_t *lb1 = computeLowerBounds(0, project);
 	if (project.numberOfActivities > 1)
 		project.criticalPathMakespan = lb1[project.numberOfActivities-1];
 	else
 		project.criticalPathMakespan = -1;
 	delete[] lb1;
+}
 
-	/* IT FILLS THE CACHES OF SUCCESSORS/PREDECESSORS */
-	for (uint32_t id = 0; id < project.numberOfActivities; ++id)	{
-		project.allSuccessorsCache.push_back(getAllActivitySuccessors(id, project));
-		project.allPredecessorsCache.push_back(getAllActivityPredecessors(id, project));
-	}
-
+void ScheduleSolver::computeRightLeftLongestPaths(InstanceData& project)	{
 	/*
 	 * It transformes the instance graph. Directions of edges are changed.
 	 * The longest paths are computed from the end dummy activity to the others.
 	 * After that the graph is transformed back.
 	 */
+	delete[] project.rightLeftLongestPaths;
 	changeDirectionOfEdges(project);
 	project.rightLeftLongestPaths = computeLowerBounds(project.numberOfActivities-1, project, true);
 	changeDirectionOfEdges(project);
+}
+
+void ScheduleSolver::initialiseInstanceDataAndInitialSolution(InstanceData& project, InstanceSolution& solution, const uint32_t& numberOfThreads, const uint32_t& numberOfPasses)	{
+	/* CREATE INIT ORDER OF ACTIVITIES */
+
+	createInitialSolution(project, solution);
+
+	/* IT FILLS THE CACHES OF SUCCESSORS/PREDECESSORS */
+	for (uint32_t id = 0; id < project.numberOfActivities; ++id)	{
+		project.allSuccessorsCache.push_back(getAllActivitySuccessors(id, project));
+		project.allPredecessorsCache.push_back(getAllActivityPredecessors(id, project));
+	}
+
+	/* IT COMPUTES THE BOUNDS OF THE PROJECT DURATION */
+	project.rightLeftLongestPaths = NULL;
+	computeInstanceBounds(project);
+	// No schedule was evaluated yet, the expected schedule length is the upper bound.
+	solution.costOfBestSchedule = project.upperBoundMakespan;
+
+	/* IMPROVE THE INITIAL ORDER BY THE PRIORITY RULES */
+	if (numberOfPasses > 0)
+		createPriorityRuleSolution(project, solution, numberOfThreads, numberOfPasses);
 
 	/* CREATE AND COPY INITIAL SCHEDULE TO THE BEST SCHEDULE */
 
@@ -486,23 +1648,164 @@ void ScheduleSolver::createInitialSolution(const InstanceData& project, Instance
 	delete[] newCurrentLevel;
 }
 
+void ScheduleSolver::createPriorityRuleSolution(const InstanceData& project, InstanceSolution& solution, const uint32_t& numberOfThreads, const uint32_t& numberOfPasses)	{
+	const uint32_t numberOfActivities = project.numberOfActivities;
+	const uint32_t numberOfRules = 4;
+
+	// The highest value is the most urgent activity for all rules.
+	uint32_t *priorities = new uint32_t[numberOfRules*numberOfActivities];
+	for (uint32_t id = 0; id < numberOfActivities; ++id)	{
+		uint32_t rankPositionalWeight = project.durationOfActivities[id];
+		for (uint32_t s = 0; s < project.numberOfSuccessors[id]; ++s)
+			rankPositionalWeight += project.durationOfActivities[project.successorsOfActivity[id][s]];
+		// Latest finish time, latest start time, most total successors, greatest rank positional weight.
+		priorities[id] = project.rightLeftLongestPaths[id];
+		priorities[numberOfActivities+id] = project.rightLeftLongestPaths[id]+project.durationOfActivities[id];
+		priorities[2*numberOfActivities+id] = project.allSuccessorsCache[id]->size();
+		priorities[3*numberOfActivities+id] = rankPositionalWeight;
+	}
+
+	uint32_t *bestStartTimesById = new uint32_t[numberOfActivities];
+	uint32_t bestScheduleLength = shakingDownEvaluation(project, solution, bestStartTimesById);
+	uint32_t bestPass = 0;
+	bool improved = false;
+
+	#pragma omp parallel num_threads(numberOfThreads)
+	{
+		uint32_t *order = new uint32_t[numberOfActivities];
+		uint32_t *startTimesById = new uint32_t[numberOfActivities];
+		uint32_t *parallelStartTimesById = new uint32_t[numberOfActivities];
+		InstanceSolution passSolution = solution;
+		passSolution.orderOfActivities = order;
+
+		#pragma omp for schedule(dynamic)
+		for (uint32_t pass = 0; pass < numberOfPasses; ++pass)	{
+			// The first passes apply the deterministic rules, each sample has its own generator so that the result does not depend on the threads.
+			uint32_t randomState = ((pass+1)*2654435761u) | 1u;
+			createPriorityList(project, priorities+(pass % numberOfRules)*numberOfActivities, (pass < numberOfRules ? NULL : &randomState), order);
+
+			uint32_t scheduleLength = forwardScheduleEvaluation(project, passSolution, startTimesById, CAPACITY_RESOLUTION);
+			uint32_t parallelScheduleLength = parallelScheduleEvaluation(project, passSolution, parallelStartTimesById);
+			if (parallelScheduleLength < scheduleLength)
+				swap(startTimesById, parallelStartTimesById);
+			// The forward-backward improvement of the sorted order.
+			convertStartTimesById2ActivitiesOrder(project, passSolution, startTimesById);
+			scheduleLength = shakingDownEvaluation(project, passSolution, startTimesById);
+
+			#pragma omp critical
+			{
+				if (scheduleLength < bestScheduleLength || (improved && scheduleLength == bestScheduleLength && pass < bestPass))	{
+					copy(order, order+numberOfActivities, solution.orderOfActivities);
+					copy(startTimesById, startTimesById+numberOfActivities, bestStartTimesById);
+					bestScheduleLength = scheduleLength;
+					bestPass = pass;
+					improved = true;
+				}
+			}
+		}
+
+		delete[] order;
+		delete[] startTimesById;
+		delete[] parallelStartTimesById;
+	}
+
+	// The serial scheme does not extend the schedule if the activities are sorted by the start times.
+	if (improved)
+		convertStartTimesById2ActivitiesOrder(project, solution, bestStartTimesById);
+
+	delete[] priorities;
+	delete[] bestStartTimesById;
+}
+
+void ScheduleSolver::createPriorityList(const InstanceData& project, const uint32_t * const& priorities, uint32_t * const& randomState, uint32_t * const& order)	{
+	const uint32_t numberOfActivities = project.numberOfActivities;
+	vector<uint32_t> unscheduledPredecessors(project.numberOfPredecessors, project.numberOfPredecessors+numberOfActivities);
+	vector<uint32_t> eligibleActivities;
+	eligibleActivities.reserve(numberOfActivities);
+	for (uint32_t id = 0; id < numberOfActivities; ++id)	{
+		if (unscheduledPredecessors[id] == 0)
+			eligibleActivities.push_back(id);
+	}
+
+	for (uint32_t position = 0; position < numberOfActivities; ++position)	{
+		if (eligibleActivities.empty())
+			throw runtime_error("ScheduleSolver::createPriorityList: The precedence graph contains a cycle!");
+
+		uint32_t selectedIdx = 0;
+		if (randomState == NULL)	{
+			// The lowest id breaks the ties.
+			for (uint32_t idx = 1; idx < eligibleActivities.size(); ++idx)	{
+				uint32_t id = eligibleActivities[idx], selectedId = eligibleActivities[selectedIdx];
+				if (priorities[id] > priorities[selectedId] || (priorities[id] == priorities[selectedId] && id < selectedId))
+					selectedIdx = idx;
+			}
+		} else {
+			uint32_t lowestPriority = UINT32_MAX;
+			uint64_t sumOfWeights = 0;
+			for (vector<uint32_t>::const_iterator it = eligibleActivities.begin(); it != eligibleActivities.end(); ++it)
+				lowestPriority = min(lowestPriority, priorities[*it]);
+			for (vector<uint32_t>::const_iterator it = eligibleActivities.begin(); it != eligibleActivities.end(); ++it)
+				sumOfWeights += priorities[*it]-lowestPriority+1;
+
+			uint64_t randomWeight = (((uint64_t) generateRandomNumber(*randomState))*sumOfWeights) >> 32;
+			while (randomWeight >= priorities[eligibleActivities[selectedIdx]]-lowestPriority+1)	{
+				randomWeight -= priorities[eligibleActivities[selectedIdx]]-lowestPriority+1;
+				++selectedIdx;
+			}
+		}
+
+		uint32_t activityId = eligibleActivities[selectedIdx];
+		eligibleActivities[selectedIdx] = eligibleActivities.back();
+		eligibleActivities.pop_back();
+		order[position] = activityId;
+
+		for (uint32_t s = 0; s < project.numberOfSuccessors[activityId]; ++s)	{
+			uint32_t successorId = project.successorsOfActivity[activityId][s];
+			if (--unscheduledPredecessors[successorId] == 0)
+				eligibleActivities.push_back(successorId);
+		}
+	}
+}
+
 ofstream& ScheduleSolver::writeBestScheduleToFile(ofstream& out, const InstanceData& project, const InstanceSolution& solution)	{
 	/* WRITE INTANCE DATA */
 	out.write((const char*) &project.numberOfActivities, sizeof(uint32_t));
 	out.write((const char*) &project.numberOfResources, sizeof(uint32_t));
 
-	out.write((const char*) project.durationOfActivities, project.numberOfActivities*sizeof(uint32_t));
-	out.write((const char*) project.capacityOfResources, project.numberOfResources*sizeof(uint32_t));
-	for (uint32_t i = 0; i < project.numberOfActivities; ++i)
-		out.write((const char*) project.requiredResourcesOfActivities[i], project.numberOfResources*sizeof(uint32_t));
+	// The data are written with the original ids of the activities.
+	const uint32_t numberOfActivities = project.numberOfActivities;
+	vector<uint32_t> internalId(numberOfActivities), durations(numberOfActivities), numberOfSuccessors(numberOfActivities), numberOfPredecessors(numberOfActivities);
+	for (uint32_t id = 0; id < numberOfActivities; ++id)
+		internalId[id] = internalActivityId(project, id, "writeBestScheduleToFile");
+	for (uint32_t i = 0; i < numberOfActivities; ++i)	{
+		durations[i] = project.durationOfActivities[internalId[i]];
+		numberOfSuccessors[i] = project.numberOfSuccessors[internalId[i]];
+		numberOfPredecessors[i] = project.numberOfPredecessors[internalId[i]];
+	}
 
-	out.write((const char*) project.numberOfSuccessors, project.numberOfActivities*sizeof(uint32_t));
-	for (uint32_t i = 0; i < project.numberOfActivities; ++i)
-		out.write((const char*) project.successorsOfActivity[i], project.numberOfSuccessors[i]*sizeof(uint32_t));
+	out.write((const char*) &durations[0], numberOfActivities*sizeof(uint32_t));
+	out.write((const char*) project.capacityOfResources, project.numberOfResources*sizeof(uint32_t));
+	for (uint32_t i = 0; i < numberOfActivities; ++i)
+		out.write((const char*) project.requiredResourcesOfActivities[internalId[i]], project.numberOfResources*sizeof(uint32_t));
+
+	out.write((const char*) &numberOfSuccessors[0], numberOfActivities*sizeof(uint32_t));
+	for (uint32_t i = 0; i < numberOfActivities; ++i)	{
+		vector<uint32_t> successors(project.successorsOfActivity[internalId[i]], project.successorsOfActivity[internalId[i]]+numberOfSuccessors[i]);
+		for (vector<uint32_t>::iterator it = successors.begin(); it != successors.end(); ++it)
+			*it = originalActivityId(project, *it);
+		if (!successors.empty())
+			out.write((const char*) &successors[0], successors.size()*sizeof(uint32_t));
+	}
 
-	out.write((const char*) project.numberOfPredecessors, project.numberOfActivities*sizeof(uint32_t));
-	for (uint32_t i = 0; i < project.numberOfActivities; ++i)
-		out.write((const char*) project.predecessorsOfActivity[i], project.numberOfPredecessors[i]*sizeof(uint32_t));
+	out.write((const char*) &numberOfPredecessors[0], numberOfActivities*sizeof(uint32_t));
+	for (uint32_t i = 0; i < numberOfActivities; ++i)	{
+		vector<uint32_t> predecessors(project.predecessorsOfActivity[internalId[i]], project.predecessorsOfActivity[internalId[i]]+numberOfPredecessors[i]);
+		for (vector<uint32_t>::iterator it = predecessors.begin(); it != predecessors.end(); ++it)
+			*it = originalActivityId(project, *it);
+		sort(predecessors.begin(), predecessors.end());
+		if (!predecessors.empty())
+			out.write((const char*) &predecessors[0], predecessors.size()*sizeof(uint32_t));
+	}
 
 	/* WRITE RESULTS */
 	InstanceSolution copySolution = solution;
@@ -510,12 +1813,18 @@ ofstream& ScheduleSolver::writeBestScheduleToFile(ofstream& out, const InstanceD
 	copySolution.orderOfActivities = new uint32_t[project.numberOfActivities];
 	copy(solution.bestScheduleOrder, solution.bestScheduleOrder+project.numberOfActivities, copySolution.orderOfActivities);
 
-	uint32_t scheduleLength = shakingDownEvaluation(project, solution, startTimesById);
+	uint32_t scheduleLength = shakingDownEvaluation(project, copySolution, startTimesById);
 	convertStartTimesById2ActivitiesOrder(project, copySolution, startTimesById);
 
+	vector<uint32_t> startTimesByOriginalId(numberOfActivities);
+	for (uint32_t i = 0; i < numberOfActivities; ++i)	{
+		startTimesByOriginalId[i] = startTimesById[internalId[i]];
+		copySolution.orderOfActivities[i] = originalActivityId(project, copySolution.orderOfActivities[i]);
+	}
+
 	out.write((const char*) &scheduleLength, sizeof(uint32_t));
-	out.write((const char*) copySolution.orderOfActivities, project.numberOfActivities*sizeof(uint32_t));
-	out.write((const char*) startTimesById, project.numberOfActivities*sizeof(uint32_t));
+	out.write((const char*) copySolution.orderOfActivities, numberOfActivities*sizeof(uint32_t));
+	out.write((const char*) &startTimesByOriginalId[0], numberOfActivities*sizeof(uint32_t));
 
 	delete[] startTimesById;
 	delete[] copySolution.orderOfActivities;
@@ -682,12 +1991,19 @@ uint32_t ScheduleSolver::computeUpperBoundsOverhangPenalty(const InstanceData& p
 	return overhangPenalty;
 }
 
-void ScheduleSolver::printSchedule(const InstanceData& project, const InstanceSolution& solution, double runTime, uint64_t evaluatedSchedules, bool verbose, ostream& output)	{
+void ScheduleSolver::printSchedule(const InstanceData& project, const InstanceSolution& solution, double runTime, double timeToBest, uint64_t evaluatedSchedules, bool verbose, ostream& output)	{
 	uint32_t *startTimesById = new uint32_t[project.numberOfActivities];
 	uint32_t scheduleLength = shakingDownEvaluation(project, solution, startTimesById);
 	uint32_t precedencePenalty = computePrecedencePenalty(project, startTimesById);
 	
 	if (verbose == true)	{
+		// The schedule is printed with the original ids of the activities.
+		uint32_t *startTimesByOriginalId = new uint32_t[project.numberOfActivities];
+		for (uint32_t id = 0; id < project.numberOfActivities; ++id)
+			startTimesByOriginalId[originalActivityId(project, id)] = startTimesById[id];
+		swap(startTimesById, startTimesByOriginalId);
+		delete[] startTimesByOriginalId;
+
 		output<<"start\tactivities"<<endl;
 		for (uint32_t c = 0; c <= scheduleLength; ++c)	{
 			bool first = true;
@@ -707,33 +2023,39 @@ void ScheduleSolver::printSchedule(const InstanceData& project, const InstanceSo
 		output<<"Precedence penalty: "<<precedencePenalty<<endl;
 		output<<"Critical path makespan: "<<project.criticalPathMakespan<<endl;
 		output<<"Schedule solve time: "<<runTime<<" s"<<endl;
+		output<<"Time to the best schedule: "<<timeToBest<<" s"<<endl;
 		output<<"Total number of evaluated schedules: "<<evaluatedSchedules<<endl;
 	}	else	{
-		output<<scheduleLength<<"+"<<precedencePenalty<<" "<<project.criticalPathMakespan<<"\t["<<runTime<<" s]\t"<<evaluatedSchedules<<endl;
+		output<<scheduleLength<<"+"<<precedencePenalty<<" "<<project.criticalPathMakespan<<"\t["<<runTime<<" s]\t"<<evaluatedSchedules<<"\t[best "<<timeToBest<<" s]"<<endl;
 	}
 
 	delete[] startTimesById;
 }
 
 uint32_t ScheduleSolver::evaluateOrder(const InstanceData& project, const InstanceSolution& solution, uint32_t *& timeValuesById, bool forwardEvaluation, EvaluationAlgorithm algorithm)	{
-	SourcesLoad *sourcesLoad;
-	if (algorithm == CAPACITY_RESOLUTION)
-		sourcesLoad = new SourcesLoadCapacityResolution(project.numberOfResources, project.capacityOfResources);
-	else
-		sourcesLoad = new SourcesLoadTimeResolution(project.numberOfResources, project.capacityOfResources, project.upperBoundMakespan);
+	SourcesLoad *sourcesLoad = createSourcesLoad(project, solution, algorithm);
+
+	// The arrays of the arena are read directly, the precedences are stored in the CSR format.
+	const uint32_t * const durations = project.durationOfActivities;
+	const uint32_t * const predecessorsOffsets = project.predecessorsOffsets;
+	const uint32_t * const predecessorIds = project.predecessorIds;
+	const uint32_t * const requirementsOffsets = project.requirementsOffsets;
 
 	uint32_t scheduleLength = 0;
 	for (uint32_t i = 0; i < project.numberOfActivities; ++i)	{
 		uint32_t start = 0;
 		uint32_t activityId = solution.orderOfActivities[forwardEvaluation == true ? i : project.numberOfActivities-i-1];
-		for (uint32_t j = 0; j < project.numberOfPredecessors[activityId]; ++j)	{
-			uint32_t predecessorActivityId = project.predecessorsOfActivity[activityId][j];
-			start = max(timeValuesById[predecessorActivityId]+project.durationOfActivities[predecessorActivityId], start);
+		for (uint32_t j = predecessorsOffsets[activityId]; j < predecessorsOffsets[activityId+1]; ++j)	{
+			uint32_t predecessorActivityId = predecessorIds[j];
+			start = max(timeValuesById[predecessorActivityId]+durations[predecessorActivityId], start);
 		}
 
-		start = max(sourcesLoad->getEarliestStartTime(project.requiredResourcesOfActivities[activityId], start, project.durationOfActivities[activityId]), start);
-		sourcesLoad->addActivity(start, start+project.durationOfActivities[activityId], project.requiredResourcesOfActivities[activityId]);
-		scheduleLength = max(scheduleLength, start+project.durationOfActivities[activityId]);
+		// Only the resources required by the activity are checked and updated.
+		const ResourceRequirement * const activityRequirements = project.resourceRequirements+requirementsOffsets[activityId];
+		const uint32_t numberOfRequirements = requirementsOffsets[activityId+1]-requirementsOffsets[activityId];
+		start = max(sourcesLoad->getEarliestStartTime(activityRequirements, numberOfRequirements, start, durations[activityId]), start);
+		sourcesLoad->addActivity(start, start+durations[activityId], activityRequirements, numberOfRequirements);
+		scheduleLength = max(scheduleLength, start+durations[activityId]);
 
 		timeValuesById[activityId] = start;
 	}
@@ -742,10 +2064,196 @@ uint32_t ScheduleSolver::evaluateOrder(const InstanceData& project, const Instan
 	return scheduleLength;
 }
 
+SourcesLoad* ScheduleSolver::createSourcesLoad(const InstanceData& project, const InstanceSolution& solution, EvaluationAlgorithm algorithm)	{
+	if (algorithm == CAPACITY_RESOLUTION)	{
+		return project.capacityResolutionFactory(project, project.upperBoundMakespan);
+	} else {
+		uint32_t timeHorizon = solution.costOfBestSchedule+(solution.costOfBestSchedule*TIME_HORIZON_MARGIN)/100+1;
+		return project.timeResolutionFactory(project, min(timeHorizon, project.upperBoundMakespan));
+	}
+}
+
+void ScheduleSolver::selectEvaluationKernels(InstanceData& project)	{
+	// The cost of the uncompressed capacity resolution grows with the capacity.
+	bool compressedLevels = (*max_element(project.capacityOfResources, project.capacityOfResources+project.numberOfResources) > COMPRESSED_CAPACITY_THRESHOLD);
+	switch (project.timeValueBytes)	{
+		case 1:
+			project.capacityResolutionFactory = capacityResolutionKernel<uint8_t>(compressedLevels);
+			break;
+		case 2:
+			project.capacityResolutionFactory = capacityResolutionKernel<uint16_t>(compressedLevels);
+			break;
+		default:
+			project.capacityResolutionFactory = capacityResolutionKernel<uint32_t>(compressedLevels);
+	}
+
+	switch (project.capacityValueBytes)	{
+		case 1:
+			project.timeResolutionFactory = timeResolutionKernel<uint8_t>(project.numberOfResources);
+			break;
+		case 2:
+			project.timeResolutionFactory = timeResolutionKernel<uint16_t>(project.numberOfResources);
+			break;
+		default:
+			project.timeResolutionFactory = timeResolutionKernel<uint32_t>(project.numberOfResources);
+	}
+}
+
+template <class T>
+ScheduleSolver::SourcesLoadFactory ScheduleSolver::capacityResolutionKernel(const bool& compressedLevels)	{
+	if (compressedLevels == true)
+		return createCompressedCapacityResolution<T>;
+	else
+		return createCapacityResolution<T>;
+}
+
+template <class T>
+ScheduleSolver::SourcesLoadFactory ScheduleSolver::timeResolutionKernel(const uint32_t& numberOfResources)	{
+	switch (numberOfResources)	{
+		case 1:
+			return createTimeResolution<T, 1>;
+		case 2:
+			return createTimeResolution<T, 2>;
+		case 3:
+			return createTimeResolution<T, 3>;
+		case 4:
+			return createTimeResolution<T, 4>;
+		case 5:
+			return createTimeResolution<T, 5>;
+		case 6:
+			return createTimeResolution<T, 6>;
+		case 7:
+			return createTimeResolution<T, 7>;
+		case 8:
+			return createTimeResolution<T, 8>;
+		default:
+			return createTimeResolution<T, 0>;
+	}
+}
+
+template <class T>
+SourcesLoad* ScheduleSolver::createCapacityResolution(const InstanceData& project, const uint32_t&)	{
+	return new SourcesLoadCapacityResolution<T>(project.numberOfResources, project.capacityOfResources);
+}
+
+template <class T>
+SourcesLoad* ScheduleSolver::createCompressedCapacityResolution(const InstanceData& project, const uint32_t&)	{
+	return new SourcesLoadCompressedCapacityResolution<T>(project.numberOfResources, project.capacityOfResources);
+}
+
+template <class T, uint32_t R>
+SourcesLoad* ScheduleSolver::createTimeResolution(const InstanceData& project, const uint32_t& timeHorizon)	{
+	return new SourcesLoadTimeResolution<T, R>(project.numberOfResources, project.capacityOfResources, timeHorizon, project.upperBoundMakespan);
+}
+
+uint8_t ScheduleSolver::narrowestIntegerBytes(const uint32_t& maxValue)	{
+	if (maxValue <= numeric_limits<uint8_t>::max())
+		return 1;
+	else if (maxValue <= numeric_limits<uint16_t>::max())
+		return 2;
+	else
+		return 4;
+}
+
 uint32_t ScheduleSolver::forwardScheduleEvaluation(const InstanceData& project, const InstanceSolution& solution, uint32_t *& startTimesById, EvaluationAlgorithm algorithm) {
 	return evaluateOrder(project, solution, startTimesById, true, algorithm);
 }
 
+uint32_t ScheduleSolver::parallelScheduleEvaluation(const InstanceData& project, const InstanceSolution& solution, uint32_t *& startTimesById)	{
+	const uint32_t numberOfActivities = project.numberOfActivities;
+	const uint32_t * const durations = project.durationOfActivities;
+	const uint32_t * const requirementsOffsets = project.requirementsOffsets;
+	const ResourceRequirement * const resourceRequirements = project.resourceRequirements;
+
+	vector<uint32_t> positionOfActivity(numberOfActivities), unfinishedPredecessors(numberOfActivities), eligiblePositions;
+	vector<uint32_t> freeCapacity(project.capacityOfResources, project.capacityOfResources+project.numberOfResources);
+	// The started activities ordered by their finish times.
+	priority_queue<pair<uint32_t, uint32_t>, vector<pair<uint32_t, uint32_t> >, greater<pair<uint32_t, uint32_t> > > runningActivities;
+	eligiblePositions.reserve(numberOfActivities);
+
+	for (uint32_t position = 0; position < numberOfActivities; ++position)	{
+		uint32_t activityId = solution.orderOfActivities[position];
+		positionOfActivity[activityId] = position;
+		unfinishedPredecessors[activityId] = project.predecessorsOffsets[activityId+1]-project.predecessorsOffsets[activityId];
+		if (unfinishedPredecessors[activityId] == 0)
+			eligiblePositions.push_back(position);
+	}
+
+	uint32_t scheduleLength = 0, decisionTime = 0, scheduledActivities = 0;
+	while (scheduledActivities < numberOfActivities)	{
+		// The finished activities release their resources and their successors can become eligible.
+		while (!runningActivities.empty() && runningActivities.top().first <= decisionTime)	{
+			uint32_t activityId = runningActivities.top().second;
+			runningActivities.pop();
+			for (uint32_t j = requirementsOffsets[activityId]; j < requirementsOffsets[activityId+1]; ++j)
+				freeCapacity[resourceRequirements[j].resourceId] += resourceRequirements[j].demand;
+			for (uint32_t j = project.successorsOffsets[activityId]; j < project.successorsOffsets[activityId+1]; ++j)	{
+				uint32_t successorId = project.successorIds[j];
+				if (--unfinishedPredecessors[successorId] == 0)	{
+					uint32_t position = positionOfActivity[successorId];
+					eligiblePositions.insert(lower_bound(eligiblePositions.begin(), eligiblePositions.end(), position), position);
+				}
+			}
+		}
+
+		// The eligible activities are started in the order of their priorities.
+		bool zeroDurationStarted = false;
+		vector<uint32_t>::iterator it = eligiblePositions.begin();
+		while (it != eligiblePositions.end())	{
+			uint32_t activityId = solution.orderOfActivities[*it];
+			bool resourcesAvailable = true;
+			for (uint32_t j = requirementsOffsets[activityId]; j < requirementsOffsets[activityId+1] && resourcesAvailable; ++j)
+				resourcesAvailable = (freeCapacity[resourceRequirements[j].resourceId] >= resourceRequirements[j].demand);
+
+			if (resourcesAvailable == true)	{
+				for (uint32_t j = requirementsOffsets[activityId]; j < requirementsOffsets[activityId+1]; ++j)
+					freeCapacity[resourceRequirements[j].resourceId] -= resourceRequirements[j].demand;
+				startTimesById[activityId] = decisionTime;
+				runningActivities.push(pair<uint32_t, uint32_t>(decisionTime+durations[activityId], activityId));
+				scheduleLength = max(scheduleLength, decisionTime+durations[activityId]);
+				zeroDurationStarted = zeroDurationStarted || (durations[activityId] == 0);
+				++scheduledActivities;
+				it = eligiblePositions.erase(it);
+			} else {
+				++it;
+			}
+		}
+
+		// The activities with zero duration finish immediately, their successors are considered at the same decision time.
+		if (zeroDurationStarted == false && scheduledActivities < numberOfActivities)	{
+			if (runningActivities.empty())
+				throw runtime_error("ScheduleSolver::parallelScheduleEvaluation: An activity requires more than the capacity of a resource!");
+			decisionTime = runningActivities.top().first;
+		}
+	}
+
+	return scheduleLength;
+}
+
+uint32_t ScheduleSolver::decodeOrder(const InstanceData& project, const InstanceSolution& solution, uint32_t *& startTimesById, EvaluationAlgorithm algorithm,
+		const ScheduleGenerationScheme& scheme)	{
+	switch (scheme)	{
+		case SERIAL_SGS:
+			return forwardScheduleEvaluation(project, solution, startTimesById, algorithm);
+		case PARALLEL_SGS:
+			return parallelScheduleEvaluation(project, solution, startTimesById);
+		case MIXED_SGS:
+			{
+				uint32_t *parallelStartTimesById = new uint32_t[project.numberOfActivities];
+				uint32_t scheduleLength = forwardScheduleEvaluation(project, solution, startTimesById, algorithm);
+				uint32_t parallelScheduleLength = parallelScheduleEvaluation(project, solution, parallelStartTimesById);
+				if (parallelScheduleLength < scheduleLength)	{
+					copy(parallelStartTimesById, parallelStartTimesById+project.numberOfActivities, startTimesById);
+					scheduleLength = parallelScheduleLength;
+				}
+				delete[] parallelStartTimesById;
+				return scheduleLength;
+			}
+		default:
+			throw runtime_error("ScheduleSolver::decodeOrder: Unsupported schedule generation scheme!");
+	}
+}
+
 uint32_t ScheduleSolver::backwardScheduleEvaluation(const InstanceData& project, const InstanceSolution& solution, uint32_t *& startTimesById, EvaluationAlgorithm algorithm) {
 	InstanceData copyProject = project;
 	changeDirectionOfEdges(copyProject);
@@ -859,11 +2367,31 @@ void ScheduleSolver::makeShift(uint32_t * const& order, const int32_t& diff, con
 	return;
 }
 
-void ScheduleSolver::makeDiversification(const InstanceData& project, InstanceSolution& solution)	{
+bool ScheduleSolver::detectCycle(const InstanceData& project, SearchTrajectory& trajectory)	{
+	const uint32_t historySize = trajectory.config->cycleDetectionHistory;
+	if (historySize == 0)
+		return false;
+
+	uint64_t orderHash = currentOrderHash(project, trajectory);
+	vector<uint64_t>& history = trajectory.recentOrderHashes;
+	bool cycleDetected = (find(history.begin(), history.end(), orderHash) != history.end());
+
+	if (history.size() < historySize)	{
+		history.push_back(orderHash);
+		trajectory.nextRecentOrderHash = 0;
+	} else {
+		history[trajectory.nextRecentOrderHash] = orderHash;
+		trajectory.nextRecentOrderHash = (trajectory.nextRecentOrderHash+1) % historySize;
+	}
+
+	return cycleDetected;
+}
+
+void ScheduleSolver::makeDiversification(const InstanceData& project, InstanceSolution& solution, const uint32_t& numberOfSwaps, uint32_t& randomState)	{
 	uint32_t performedSwaps = 0;
-	while (performedSwaps < ConfigureRCPSP::DIVERSIFICATION_SWAPS)	{
-		uint32_t i = (rand() % (project.numberOfActivities-2)) + 1;
-		uint32_t j = (rand() % (project.numberOfActivities-2)) + 1;
+	while (performedSwaps < numberOfSwaps)	{
+		uint32_t i = (generateRandomNumber(randomState) % (project.numberOfActivities-2)) + 1;
+		uint32_t j = (generateRandomNumber(randomState) % (project.numberOfActivities-2)) + 1;
 
 		if ((i != j) && (checkSwapPrecedencePenalty(project, solution, i, j) == true))	{
 			swap(solution.orderOfActivities[i], solution.orderOfActivities[j]);
@@ -872,9 +2400,197 @@ void ScheduleSolver::makeDiversification(const InstanceData& project, InstanceSo
 	}
 }
 
+void ScheduleSolver::startSearchFromOrder(const uint32_t * const& order)	{
+	const uint32_t numberOfActivities = instance.numberOfActivities;
+	// The earlier position in the given order is the higher priority.
+	uint32_t *priorities = new uint32_t[numberOfActivities];
+	for (uint32_t position = 0; position < numberOfActivities; ++position)
+		priorities[order[position]] = numberOfActivities-position;
+
+	// The list generation selects the first activity of the order whose predecessors are ordered, it repairs the precedence violations.
+	InstanceSolution& solution = trajectories[0].solution;
+	createPriorityList(instance, priorities, NULL, solution.orderOfActivities);
+	delete[] priorities;
+
+	uint32_t *startTimesById = new uint32_t[numberOfActivities];
+	solution.costOfBestSchedule = instance.upperBoundMakespan;
+	solution.costOfBestSchedule = shakingDownEvaluation(instance, solution, startTimesById);
+	convertStartTimesById2ActivitiesOrder(instance, solution, startTimesById);
+	copy(solution.orderOfActivities, solution.orderOfActivities+numberOfActivities, solution.bestScheduleOrder);
+	delete[] startTimesById;
+
+	if (numberOfIslands > 1)
+		copyInitialSolutionToIslands();
+	for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+		trajectories[island].numberOfIterSinceBest = 0;
+		trajectories[island].speculationValid = false;
+		trajectories[island].orderHashValid = false;
+	}
+}
+
+void ScheduleSolver::continueAfterInstanceChange(const double& startTime)	{
+	// The cached costs and the elite orders were evaluated for the old instance.
+	if (evaluationCache != NULL)
+		evaluationCache->invalidate();
+	if (elitePool != NULL)
+		elitePool->clear();
+	if (numaTopology != NULL)	{
+		for (vector<InstanceData*>::iterator it = numaReplicas.begin(); it != numaReplicas.end(); ++it)
+			destroyInstanceDataReplica(*it);
+		createNumaReplicas();
+	}
+
+	// The best order is copied because the orders of the trajectories are overwritten.
+	const InstanceSolution& bestSolution = getBestTrajectory().solution;
+	vector<uint32_t> bestOrder(bestSolution.bestScheduleOrder, bestSolution.bestScheduleOrder+instance.numberOfActivities);
+	startSearchFromOrder(&bestOrder[0]);
+
+	setupTime += getWallClockTime()-startTime;
+}
+
+void ScheduleSolver::prepareEvaluationCache(const uint32_t& maxIter)	{
+	if (config.evaluationCacheSize == 0)
+		return;
+
+	// The swap range of the trajectory is at most doubled by the adaptive strategy, the shift moves go in both directions.
+	const uint64_t numberOfActivities = instance.numberOfActivities;
+	uint64_t movesPerIteration = numberOfActivities*(min<uint64_t>(2*((uint64_t) config.swapRange), numberOfActivities)+2*((uint64_t) config.shiftRange));
+	movesPerIteration = max<uint64_t>((movesPerIteration*config.neighbourhoodSamplePercentage)/100, 1);
+	uint64_t numberOfEntries = min<uint64_t>(config.evaluationCacheSize, ((uint64_t) maxIter)*numberOfIslands*movesPerIteration);
+	if (numberOfEntries == 0 || (evaluationCache != NULL && evaluationCache->getNumberOfEntries() >= numberOfEntries))
+		return;
+
+	delete evaluationCache;
+	evaluationCache = new EvaluationCache((uint32_t) numberOfEntries);
+	for (uint32_t island = 0; island < numberOfIslands; ++island)
+		trajectories[island].evaluationCache = evaluationCache;
+}
+
+void ScheduleSolver::changePrecedenceEdge(const uint32_t& activityId, const uint32_t& successorId, const bool& addEdge)	{
+	const uint32_t numberOfActivities = instance.numberOfActivities;
+	const uint32_t startActivityId = 0, endActivityId = numberOfActivities-1;
+	vector<vector<uint32_t> > successors = getSuccessorLists(instance);
+	if (addEdge == true)	{
+		successors[activityId].push_back(successorId);
+	} else {
+		vector<uint32_t>& successorsOfActivity = successors[activityId];
+		successorsOfActivity.erase(find(successorsOfActivity.begin(), successorsOfActivity.end(), successorId));
+		// The dummy start and end activities remain the only source and sink of the precedence graph.
+		// The last edges from the start activity and to the end activity are never removed (see removePrecedence).
+		if (instance.numberOfPredecessors[successorId] == 1)
+			successors[startActivityId].push_back(successorId);
+		if (instance.numberOfSuccessors[activityId] == 1)
+			successorsOfActivity.push_back(endActivityId);
+	}
+
+	// Only the activity and its ancestors can change their successors, the successor and its descendants their predecessors.
+	vector<bool> successorsOutdated(numberOfActivities, false), predecessorsOutdated(numberOfActivities, false);
+	successorsOutdated[activityId] = successorsOutdated[startActivityId] = true;
+	for (vector<uint32_t>::const_iterator it = instance.allPredecessorsCache[activityId]->begin(); it != instance.allPredecessorsCache[activityId]->end(); ++it)
+		successorsOutdated[*it] = true;
+	predecessorsOutdated[successorId] = predecessorsOutdated[endActivityId] = true;
+	for (vector<uint32_t>::const_iterator it = instance.allSuccessorsCache[successorId]->begin(); it != instance.allSuccessorsCache[successorId]->end(); ++it)
+		predecessorsOutdated[*it] = true;
+
+	rebuildInstanceArena(instance, successors);
+	updateTransitiveCaches(instance, successorsOutdated, predecessorsOutdated);
+	// The durations and the capacities are not changed, only the longest paths have to be recomputed.
+	computeCriticalPathMakespan(instance);
+	computeRightLeftLongestPaths(instance);
+}
+
+void ScheduleSolver::createNumaReplicas()	{
+	// Each node gets its own replica of the instance data, it is allocated and first touched by a thread bound to the node.
+	uint32_t numberOfNodes = numaTopology->getNumberOfNodes();
+	numaReplicas.assign(numberOfNodes, NULL);
+	vector<thread> replicaBuilders;
+	for (uint32_t node = 0; node < numberOfNodes; ++node)
+		replicaBuilders.push_back(thread(buildNumaReplica, &instance, numaTopology, node, &numaReplicas[node]));
+	for (vector<thread>::iterator it = replicaBuilders.begin(); it != replicaBuilders.end(); ++it)
+		it->join();
+
+	// Neighbouring islands share the node.
+	for (uint32_t island = 0; island < numberOfIslands; ++island)	{
+		SearchTrajectory& trajectory = trajectories[island];
+		trajectory.numaNode = (island*numberOfNodes)/numberOfIslands;
+		trajectory.numaTopology = numaTopology;
+		trajectory.project = numaReplicas[trajectory.numaNode];
+	}
+}
+
+void ScheduleSolver::copyInitialSolutionToIslands()	{
+	// Other islands start from diversified copies of the initial solution.
+	const InstanceSolution& initialSolution = trajectories[0].solution;
+	for (uint32_t island = 1; island < numberOfIslands; ++island)	{
+		InstanceSolution& solution = trajectories[island].solution;
+		if (solution.orderOfActivities == NULL)	{
+			solution.orderOfActivities = new uint32_t[instance.numberOfActivities];
+			solution.bestScheduleOrder = new uint32_t[instance.numberOfActivities];
+		}
+		solution.costOfBestSchedule = initialSolution.costOfBestSchedule;
+		copy(initialSolution.orderOfActivities, initialSolution.orderOfActivities+instance.numberOfActivities, solution.orderOfActivities);
+		copy(initialSolution.bestScheduleOrder, initialSolution.bestScheduleOrder+instance.numberOfActivities, solution.bestScheduleOrder);
+		makeDiversification(instance, solution, config.diversificationSwaps, trajectories[island].randomState);
+	}
+}
+
+vector<uint32_t> ScheduleSolver::readWarmStartOrder(const string& filename, const uint32_t& numberOfActivities)	{
+	bool resultFile = (filename.size() > 4 && filename.compare(filename.size()-4, 4, ".res") == 0);
+	ifstream in(filename.c_str(), (resultFile ? ios::in | ios::binary : ios::in));
+	if (!in)
+		throw invalid_argument("ScheduleSolver::readWarmStartOrder: Cannot open the warm start file \""+filename+"\"!");
+
+	vector<uint32_t> order;
+	if (resultFile == true)	{
+		// The layout of the file is given by writeBestScheduleToFile.
+		uint32_t storedNumberOfActivities = 0, numberOfResources = 0;
+		in.read((char*) &storedNumberOfActivities, sizeof(uint32_t));
+		in.read((char*) &numberOfResources, sizeof(uint32_t));
+		if (!in || storedNumberOfActivities != numberOfActivities)
+			throw invalid_argument("ScheduleSolver::readWarmStartOrder: The result file does not match the instance!");
+
+		// The durations, the capacities, the requirements, the successors and the predecessors are skipped.
+		in.seekg(sizeof(uint32_t)*(numberOfActivities+numberOfResources+((uint64_t) numberOfActivities)*numberOfResources), ios::cur);
+		vector<uint32_t> numberOfRelated(numberOfActivities);
+		for (uint32_t i = 0; i < 2; ++i)	{
+			in.read((char*) &numberOfRelated[0], numberOfActivities*sizeof(uint32_t));
+			in.seekg(sizeof(uint32_t)*accumulate(numberOfRelated.begin(), numberOfRelated.end(), (uint64_t) 0), ios::cur);
+		}
+
+		uint32_t scheduleLength = 0;
+		vector<uint32_t> storedOrder(numberOfActivities), startTimesById(numberOfActivities);
+		in.read((char*) &scheduleLength, sizeof(uint32_t));
+		in.read((char*) &storedOrder[0], numberOfActivities*sizeof(uint32_t));
+		in.read((char*) &startTimesById[0], numberOfActivities*sizeof(uint32_t));
+		if (!in)
+			throw runtime_error("ScheduleSolver::readWarmStartOrder: The result file is corrupted!");
+
+		// The activities are sorted by the start times, the stored order breaks the ties.
+		vector<pair<uint32_t, uint32_t> > startTimesAndPositions(numberOfActivities);
+		for (uint32_t position = 0; position < numberOfActivities; ++position)	{
+			if (storedOrder[position] >= numberOfActivities)
+				throw runtime_error("ScheduleSolver::readWarmStartOrder: Invalid activity id in the result file!");
+			startTimesAndPositions[position] = pair<uint32_t, uint32_t>(startTimesById[storedOrder[position]], position);
+		}
+		sort(startTimesAndPositions.begin(), startTimesAndPositions.end());
+		for (vector<pair<uint32_t, uint32_t> >::const_iterator it = startTimesAndPositions.begin(); it != startTimesAndPositions.end(); ++it)
+			order.push_back(storedOrder[it->second]);
+	} else {
+		uint32_t activityId;
+		while (in>>activityId)
+			order.push_back(activityId);
+		if (!in.eof())
+			throw runtime_error("ScheduleSolver::readWarmStartOrder: Invalid activity id in the warm start file!");
+	}
+
+	return order;
+}
+
 void ScheduleSolver::changeDirectionOfEdges(InstanceData& project)	{
 	swap(project.numberOfSuccessors, project.numberOfPredecessors);
 	swap(project.successorsOfActivity, project.predecessorsOfActivity);
+	swap(project.successorsOffsets, project.predecessorsOffsets);
+	swap(project.successorIds, project.predecessorIds);
 	for (uint32_t i = 0; i < project.numberOfActivities; ++i)
 		swap(project.allSuccessorsCache[i], project.allPredecessorsCache[i]);
 }
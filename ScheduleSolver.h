@@ -23,14 +23,25 @@
  * \brief RCPSP solver class.
  */
 
+#include <cstdio>
 #include <iostream>
 #include <string>
+#include <vector>
 #include "ConfigureRCPSP.h"
+#include "ElitePool.h"
+#include "EvaluationCache.h"
 #include "InputReader.h"
+#include "NumaTopology.h"
+#include "SourcesLoad.h"
 #include "TabuList.h"
 
 /*!
  * Tabu search meta heuristic is used to solve RCPSP. Multiprocessors are effectively exploited by OpenMP library.
+ * Either all threads evaluate the neighbourhood of one search trajectory or the threads are split into groups (islands),
+ * each island has its own trajectory, and the islands periodically exchange their best orders through the elite pool.
+ * In the portfolio mode the islands differ in the type of the tabu list, the tabu list size and the swap range.
+ * In the asynchronous mode the islands are walkers without any common barrier, they share only the lock-free record
+ * of the best makespan and the concurrent elite pool.
  * \class ScheduleSolver
  * \brief Instance of this class is able to solve resource constrained project scheduling problem.
  */
@@ -39,22 +50,94 @@ class ScheduleSolver {
 	struct InstanceData;
 	//! A forward declaration of the InstanceSolution inner class.
 	struct InstanceSolution;
+	//! A forward declaration of the SearchTrajectory inner class.
+	struct SearchTrajectory;
+	//! A forward declaration of the EvaluatedMove inner class.
+	struct EvaluatedMove;
+	//! A forward declaration of the MoveLowerBoundData inner class.
+	struct MoveLowerBoundData;
+	//! The function that creates the empty state of the resources for the given instance and the expected schedule length.
+	typedef SourcesLoad* (*SourcesLoadFactory)(const InstanceData& project, const uint32_t& timeHorizon);
 
 	public:
 		/*!
 		 * \param rcpspData Data of the project instance.
-		 * \exception invalid_argument Invalid type of tabu list.
+		 * \param numberOfThreads The number of threads used by the solver. All available threads are used if it is zero.
+		 * \param solverConfig The configuration of the solver, it is copied. The default values are used if it is not given.
+		 * \exception invalid_argument Invalid type of tabu list or invalid setting of the islands.
 		 * \brief Copy pointers of project data, initialize required structures, create initial activities order, ...
 		 */
-		ScheduleSolver(const InputReader& rcpspData);
+		ScheduleSolver(const InputReader& rcpspData, const uint32_t& numberOfThreads = 0, const SolverConfig& solverConfig = SolverConfig());
+
+		/*!
+		 * \param order The order of all activities with the ids of the input file, e.g. the order of a previous solution.
+		 * \exception invalid_argument The order is not a permutation of the activities of the instance.
+		 * \brief The search starts from the given order instead of the created initial solution (warm start).
+		 * The precedence violations are repaired, each activity is moved behind its predecessors and the relative order
+		 * of the other activities is kept. The other islands start from diversified copies of the repaired order.
+		 */
+		void setInitialSolution(const std::vector<uint32_t>& order);
+		/*!
+		 * \param filename The text file with the order of activities (the ids of the input file delimited by white spaces)
+		 * or the .res file written by writeBestScheduleToFile. The activities of the .res file are ordered by their start times.
+		 * \exception invalid_argument The file cannot be opened or it does not match the instance.
+		 * \exception runtime_error The file cannot be read.
+		 * \brief The search starts from the order or the schedule stored in the file.
+		 */
+		void setInitialSolution(const std::string& filename);
+
+		/*!
+		 * \param activityId The id of the activity in the input file.
+		 * \param duration The new duration of the activity.
+		 * \exception invalid_argument Invalid id of the activity.
+		 * \brief The instance is changed, the search continues from the best found order (see continueAfterInstanceChange).
+		 */
+		void changeActivityDuration(const uint32_t& activityId, const uint32_t& duration);
+		/*!
+		 * \param activityId The id of the activity in the input file.
+		 * \param resourceId The id of the resource.
+		 * \param demand The new requirement of the activity, it cannot exceed the capacity of the resource.
+		 * \exception invalid_argument Invalid id of the activity or the resource or the demand exceeds the capacity.
+		 * \brief The instance is changed, the search continues from the best found order (see continueAfterInstanceChange).
+		 * The arena is rebuilt only if the number of the non-zero requirements of the activity changes.
+		 */
+		void changeResourceRequirement(const uint32_t& activityId, const uint32_t& resourceId, const uint32_t& demand);
+		/*!
+		 * \param resourceId The id of the resource.
+		 * \param capacity The new capacity of the resource, it cannot be lower than a requirement of an activity.
+		 * \exception invalid_argument Invalid id of the resource or the capacity is lower than a requirement.
+		 * \brief The instance is changed, the search continues from the best found order (see continueAfterInstanceChange).
+		 */
+		void changeResourceCapacity(const uint32_t& resourceId, const uint32_t& capacity);
+		/*!
+		 * \param activityId The id of the activity in the input file.
+		 * \param successorId The id of the new successor of the activity in the input file.
+		 * \exception invalid_argument Invalid id of an activity, the edge exists or it would create a cycle.
+		 * \brief The precedence edge is added, the orders that violate it are repaired and the search continues from the best found order.
+		 */
+		void addPrecedence(const uint32_t& activityId, const uint32_t& successorId);
+		/*!
+		 * \param activityId The id of the activity in the input file.
+		 * \param successorId The id of the successor of the activity in the input file.
+		 * \exception invalid_argument Invalid id of an activity, the edge does not exist or it is the last edge from the start activity
+		 * to the successor (from the activity to the end activity).
+		 * \brief The precedence edge is removed, the search continues from the best found order. The activity that loses its last
+		 * predecessor becomes a successor of the start activity, the activity that loses its last successor becomes a predecessor
+		 * of the end activity. The start and the end activity thus remain the only source and sink of the precedence graph.
+		 */
+		void removePrecedence(const uint32_t& activityId, const uint32_t& successorId);
 
 		/*!
 		 * \param maxIter Number of iterations that should be performed.
-		 * \param graphFilename Filename of generated graph (csv file).
+		 * \param graphFilename Filename of generated graph (csv file). The graph is not written in the island mode.
+		 * \param timeLimit The wall clock time budget of this call at seconds. Zero means no limit. The initialisation, the warm start
+		 * and the instance changes are charged to the next call, i.e. the first call also pays for the initialisation.
 		 * \exception runtime_error Unsupported type of move.
-		 * \brief Use tabu search to find a good quality solution.
+		 * \brief Use tabu search to find a good quality solution. The search is stopped after maxIter iterations
+		 * or when the time budget is exhausted, the best found order is kept in both cases. The next call continues
+		 * the search with its own budget.
 		 */
-		void solveSchedule(const uint32_t& maxIter = ConfigureRCPSP::NUMBER_OF_ITERATIONS, const std::string& graphFilename = "");
+		void solveSchedule(const uint32_t& maxIter = DEFAULT_NUMBER_OF_ITERATIONS, const std::string& graphFilename = "", const double& timeLimit = DEFAULT_TIME_LIMIT);
 		/*!
 		 * \param verbose If true then verbose mode is turn on.
 		 * \param output Output stream.
@@ -67,18 +150,118 @@ class ScheduleSolver {
 		 * \brief It writes required data structures and the best schedule to the given file.
 		 */
 		void writeBestScheduleToFile(const std::string& filename);
+		/*!
+		 * \param startTimes The start times of the activities indexed by the ids of the input file.
+		 * \return The length of the best found schedule.
+		 * \brief It returns the best found schedule, it is the same schedule as printed by printBestSchedule.
+		 */
+		uint32_t getBestSchedule(std::vector<uint32_t>& startTimes) const;
+		//! Return the run time of the last solveSchedule call (including the preceding initialisation, warm start and instance changes) at seconds.
+		double getTotalRunTime() const { return totalRunTime; }
+		//! Return the time from the start of the last solveSchedule call (including the preceding work) to the best solution at seconds.
+		double getTimeToBest() const { return timeToBest; }
+		//! Return the number of evaluated schedules of the last solveSchedule call summed over all islands.
+		uint64_t getNumberOfEvaluatedSchedules() const;
 
 		//! Free all allocated resources.
 		~ScheduleSolver();
 
 	protected:
 
+		/*!
+		 * \param project The instance data whose arena is created.
+		 * \param rcpspData The read instance.
+		 * \param renumberActivities If true then the activities are relabelled in the level order of the precedence graph
+		 * (the order of createInitialSolution) so that the evaluation accesses the arrays mostly sequentially.
+		 * The renumbering is skipped if the level order does not keep the dummy activities at the ends.
+		 * \brief It copies the read instance to the arena, the activities are optionally renumbered.
+		 */
+		static void initialiseInstanceArena(InstanceData& project, const InputReader& rcpspData, const bool& renumberActivities);
+		/*!
+		 * \param project The instance data.
+		 * \param activityId The internal id of the activity.
+		 * \return The id of the activity in the input file.
+		 */
+		static uint32_t originalActivityId(const InstanceData& project, const uint32_t& activityId);
+		/*!
+		 * \param project The instance data.
+		 * \param activityId The id of the activity in the input file.
+		 * \param method The name of the calling method, it is a part of the error message.
+		 * \exception invalid_argument Invalid id of the activity.
+		 * \return The internal id of the activity.
+		 */
+		static uint32_t internalActivityId(const InstanceData& project, const uint32_t& activityId, const std::string& method);
+		/*!
+		 * \param project The instance data with the set number of activities and resources. The arena is created.
+		 * \param durations Durations of the activities.
+		 * \param capacities Capacities of the resources.
+		 * \param successors Successors of the activities.
+		 * \param numberOfSuccessors Number of successors of each activity.
+		 * \param requirements Resource requirements of the activities.
+		 * \brief The instance data are copied to one aligned arena. Successors and predecessors are stored in the CSR format,
+		 * requirements and the matrix of successors as dense row-major matrices.
+		 */
+		static void createInstanceArena(InstanceData& project, const uint32_t * const& durations, const uint32_t * const& capacities,
+				const uint32_t * const * const& successors, const uint32_t * const& numberOfSuccessors, const uint32_t * const * const& requirements);
+		/*!
+		 * \param project The instance data whose arena pointers are set. The number of activities, resources and edges is required.
+		 * \param arena The aligned arena. If NULL then only the size of the arena is computed.
+		 * \return The size of the arena in bytes.
+		 * \brief The arrays of the instance data are mapped to the sections of the arena.
+		 */
+		static size_t mapInstanceArena(InstanceData& project, uint8_t *arena);
+		/*!
+		 * \param arena The aligned arena or NULL.
+		 * \param offset The offset of the section, it is moved to the next aligned section.
+		 * \param sizeOfSection The size of the section in bytes.
+		 * \return The pointer to the section or NULL if the arena is NULL.
+		 */
+		static uint8_t* arenaSection(uint8_t *arena, size_t& offset, const size_t& sizeOfSection);
+		//! Return the first aligned address of the allocated arena memory.
+		static uint8_t* alignInstanceArena(uint8_t *arenaMemory);
+		//! The row pointers of the successors, predecessors, requirements and the matrix of successors are created.
+		static void createArenaRowPointers(InstanceData& project);
+		//! Free the arena and the row pointers of the instance data.
+		static void freeInstanceArena(InstanceData& project);
+		/*!
+		 * \param project The instance data whose arena is replaced.
+		 * \param successors The successors of each activity.
+		 * \brief The arena is created again with the durations, the capacities and the requirements of the old arena and the given successors.
+		 */
+		static void rebuildInstanceArena(InstanceData& project, const std::vector<std::vector<uint32_t> >& successors);
+		//! Return the successors of each activity.
+		static std::vector<std::vector<uint32_t> > getSuccessorLists(const InstanceData& project);
+		/*!
+		 * \param project The instance data with the changed precedence graph.
+		 * \param successorsOutdated The activities whose caches of all successors are computed again.
+		 * \param predecessorsOutdated The activities whose caches of all predecessors are computed again.
+		 * \brief The outdated caches are computed from the caches of the direct successors (predecessors) in the topological order.
+		 */
+		static void updateTransitiveCaches(InstanceData& project, const std::vector<bool>& successorsOutdated, const std::vector<bool>& predecessorsOutdated);
+		/*!
+		 * \param project The instance data with the durations, the requirements, the capacities and the caches of the successors/predecessors.
+		 * \brief The upper bound of the makespan, the evaluation kernels, the critical path makespan and the longest paths
+		 * to the end activity are computed.
+		 */
+		static void computeInstanceBounds(InstanceData& project);
+		/*!
+		 * \param project The instance data with the durations and the capacities.
+		 * \brief The upper bound of the makespan, the narrowest types of the stored times and capacities and the evaluation kernels are selected.
+		 */
+		static void selectValueTypes(InstanceData& project);
+		//! The length of the critical path is computed, it depends only on the durations and the precedences.
+		static void computeCriticalPathMakespan(InstanceData& project);
+		//! The longest paths from the activities to the end activity (including the energy reasoning over the resources) are computed.
+		static void computeRightLeftLongestPaths(InstanceData& project);
+
 		/*!
 		 * \param project The data-structure of the read instance.
 		 * \param solution The data-structure which stores an initial solution of the project instance.
+		 * \param numberOfThreads The number of threads that evaluate the passes of the priority rule heuristic.
+		 * \param numberOfPasses The number of passes of the priority rule heuristic. Zero keeps the level order.
 		 * \brief It initialises auxiliary data-structures of the read instance and creates the initial solution.
 		 */
-		static void initialiseInstanceDataAndInitialSolution(InstanceData& project, InstanceSolution& solution);
+		static void initialiseInstanceDataAndInitialSolution(InstanceData& project, InstanceSolution& solution, const uint32_t& numberOfThreads, const uint32_t& numberOfPasses);
 
 
 		/*!
@@ -87,6 +270,24 @@ class ScheduleSolver {
 		 * \brief An initial order of activities is created using precedence graph stored in the project data-structure.
 		 */
 		static void createInitialSolution(const InstanceData& project, InstanceSolution& solution);
+		/*!
+		 * \param project The data of the instance. The longest paths to the end activity and the caches of the successors are required.
+		 * \param solution The solution with the initial order, the order is replaced if a pass finds a shorter schedule.
+		 * \param numberOfThreads The passes are evaluated concurrently by this number of threads.
+		 * \param numberOfPasses The number of passes, the first four passes are the deterministic rules.
+		 * \brief The multi-pass priority rule heuristic. The lists of the LFT, LST, MTS and GRPW rules and the regret-biased samples
+		 * of these rules are decoded by both the serial and the parallel scheme, the shortest schedule sorted by the start times is kept.
+		 */
+		static void createPriorityRuleSolution(const InstanceData& project, InstanceSolution& solution, const uint32_t& numberOfThreads, const uint32_t& numberOfPasses);
+		/*!
+		 * \param project The data of the instance.
+		 * \param priorities The priority value of each activity, the eligible activity with the highest value is selected.
+		 * \param randomState The state of the generator of the regret-biased sampling or NULL if the deterministic rule is applied.
+		 * \param order The precedence feasible order of activities is written to this array.
+		 * \brief The serial list generation. In the sampling mode the probability of an eligible activity is proportional
+		 * to its regret (the difference from the lowest priority of the eligible activities) plus one.
+		 */
+		static void createPriorityList(const InstanceData& project, const uint32_t * const& priorities, uint32_t * const& randomState, uint32_t * const& order);
 
 		/*!
 		 * \param out The output stream where the instance data and the solution will be written.
@@ -121,12 +322,13 @@ class ScheduleSolver {
 		 * \param project The data of the printed instance.
 		 * \param solution The solution of the instance.
 		 * \param runTime The computation time at seconds.
+		 * \param timeToBest The time at seconds after which the printed solution was found.
 		 * \param evaluatedSchedules The number of evaluated schedules during execution.
 		 * \param verbose If true then verbose mode is turn on.
 		 * \param output Output stream.
 		 * \brief Print schedule, schedule length, precedence penalty and number of evaluated schedules.
 		 */
-		static void printSchedule(const InstanceData& project, const InstanceSolution& solution, double runTime, uint64_t evaluatedSchedules, bool verbose = true, std::ostream& output = std::cout);
+		static void printSchedule(const InstanceData& project, const InstanceSolution& solution, double runTime, double timeToBest, uint64_t evaluatedSchedules, bool verbose = true, std::ostream& output = std::cout);
 
 		/*!
 		 * \param project The data of the instance. (activity duration, precedence edges, ...)
@@ -139,6 +341,49 @@ class ScheduleSolver {
 		 * \warning Order of activities is sequence of putting to the schedule, time values don't have to be ordered.
 		 */
 		static uint32_t evaluateOrder(const InstanceData& project, const InstanceSolution& solution, uint32_t *& timeValuesById, bool forwardEvaluation, EvaluationAlgorithm algorithm);
+		/*!
+		 * \param project The data of the instance with the selected evaluation kernels.
+		 * \param solution The solution whose best makespan determines the expected length of the evaluated schedule.
+		 * \param algorithm The selected evaluation algorithm.
+		 * \return The empty state of the resources, the caller is responsible for its deletion.
+		 * \brief The time resolution stores the resources only up to the best makespan plus TIME_HORIZON_MARGIN percent, it grows if needed.
+		 */
+		static SourcesLoad* createSourcesLoad(const InstanceData& project, const InstanceSolution& solution, EvaluationAlgorithm algorithm);
+		/*!
+		 * \param project The data of the instance, the factories of the evaluators are set.
+		 * \brief The evaluators with the narrowest integer types that can hold the stored values are selected. The time resolution
+		 * evaluator is specialized for the number of resources if it is at most MAX_SPECIALIZED_RESOURCES. The capacity resolution
+		 * evaluator with the compressed levels is selected if a capacity is higher than COMPRESSED_CAPACITY_THRESHOLD.
+		 */
+		static void selectEvaluationKernels(InstanceData& project);
+		/*!
+		 * \tparam T The type of the time values.
+		 * \param compressedLevels If true then the release times of the units are stored as distinct levels.
+		 * \return The factory of the capacity resolution evaluator.
+		 */
+		template <class T>
+		static SourcesLoadFactory capacityResolutionKernel(const bool& compressedLevels);
+		/*!
+		 * \tparam T The type of the capacity values.
+		 * \param numberOfResources The number of resources of the instance.
+		 * \return The factory of the time resolution evaluator specialized for the number of resources or the generic one.
+		 */
+		template <class T>
+		static SourcesLoadFactory timeResolutionKernel(const uint32_t& numberOfResources);
+		//! It creates the capacity resolution evaluator that stores the times as T values.
+		template <class T>
+		static SourcesLoad* createCapacityResolution(const InstanceData& project, const uint32_t&);
+		//! It creates the capacity resolution evaluator with the compressed levels that stores the times as T values.
+		template <class T>
+		static SourcesLoad* createCompressedCapacityResolution(const InstanceData& project, const uint32_t&);
+		//! It creates the time resolution evaluator that stores the capacities as T values and is specialized for R resources.
+		template <class T, uint32_t R>
+		static SourcesLoad* createTimeResolution(const InstanceData& project, const uint32_t& timeHorizon);
+		/*!
+		 * \param maxValue The maximal stored value.
+		 * \return The size in bytes (1, 2 or 4) of the narrowest unsigned integer type that can hold the value.
+		 */
+		static uint8_t narrowestIntegerBytes(const uint32_t& maxValue);
 
 		/*!
 		 * \param project The data of the instance.
@@ -149,6 +394,29 @@ class ScheduleSolver {
 		 * \brief It evaluates order of activities and determines the earliest start time values.
 		 */
 		static uint32_t forwardScheduleEvaluation(const InstanceData& project, const InstanceSolution& solution, uint32_t *& startTimesById, EvaluationAlgorithm algorithm);
+		/*!
+		 * \param project The data of the instance.
+		 * \param solution Current solution of the instance, the position in the order is the priority of the activity.
+		 * \param startTimesById The start time values for each scheduled activity.
+		 * \exception runtime_error An activity requires more than the capacity of a resource.
+		 * \return Project makespan, i.e. the length of the schedule.
+		 * \brief The parallel (time incrementing) schedule generation scheme. At each decision time the finished activities release
+		 * their resources and the eligible activities are started in the order of their priorities if the free capacities suffice.
+		 * The free capacities are kept only for the decision time, the resources are never over-allocated in the future.
+		 */
+		static uint32_t parallelScheduleEvaluation(const InstanceData& project, const InstanceSolution& solution, uint32_t *& startTimesById);
+		/*!
+		 * \param project The data of the instance.
+		 * \param solution Current solution of the instance.
+		 * \param startTimesById The start time values for each scheduled activity.
+		 * \param algorithm The selected evaluation algorithm of the serial scheme.
+		 * \param scheme The schedule generation scheme that decodes the order.
+		 * \exception runtime_error Unsupported schedule generation scheme.
+		 * \return Project makespan, i.e. the length of the schedule.
+		 * \brief The order is decoded by the given schedule generation scheme.
+		 */
+		static uint32_t decodeOrder(const InstanceData& project, const InstanceSolution& solution, uint32_t *& startTimesById, EvaluationAlgorithm algorithm,
+				const ScheduleGenerationScheme& scheme);
 		/*!
 		 * \param project The data-structure of the instance.
 		 * \param solution Current solution of the instance.
@@ -211,9 +479,247 @@ class ScheduleSolver {
 		/*!
 		 * \param project The data of the instance.
 		 * \param solution A solution in which a diversification will be performed.
+		 * \param numberOfSwaps The number of performed random swaps.
+		 * \param randomState The state of the random number generator of the trajectory.
 		 * \brief Random swaps are performed when diversification is called..
 		 */
-		static void makeDiversification(const InstanceData& project, InstanceSolution& solution);
+		static void makeDiversification(const InstanceData& project, InstanceSolution& solution, const uint32_t& numberOfSwaps, uint32_t& randomState);
+		//! The islands except the first one start from diversified copies of the solution of the first island.
+		void copyInitialSolutionToIslands();
+		/*!
+		 * \param order The order of all activities with the internal ids, it may violate the precedences.
+		 * \brief The order is repaired (each activity is moved behind its predecessors), improved by the shaking down
+		 * and set as the current and the best order of all islands. The other islands start from its diversified copies.
+		 */
+		void startSearchFromOrder(const uint32_t * const& order);
+		/*!
+		 * \param startTime The wall clock time at which the change of the instance started.
+		 * \brief The cached costs, the elite orders and the NUMA replicas are discarded because they belong to the old instance.
+		 * The search continues from the best found order that is repaired and evaluated for the changed instance.
+		 */
+		void continueAfterInstanceChange(const double& startTime);
+		/*!
+		 * \param maxIter Number of iterations of the following search.
+		 * \brief The evaluation cache is allocated before the search if it is enabled. The table is not larger than the number
+		 * of the moves that the islands can evaluate in maxIter iterations since a larger table would never be filled.
+		 * The existing cache is kept if it is large enough.
+		 */
+		void prepareEvaluationCache(const uint32_t& maxIter);
+		/*!
+		 * \param activityId The internal id of the activity.
+		 * \param successorId The internal id of the successor.
+		 * \param addEdge If true then the edge is added else it is removed.
+		 * \brief The precedence graph, the arena and the affected caches of the successors/predecessors are updated.
+		 */
+		void changePrecedenceEdge(const uint32_t& activityId, const uint32_t& successorId, const bool& addEdge);
+		//! Each NUMA node gets its own replica of the instance data, the islands are assigned to the nodes.
+		void createNumaReplicas();
+		/*!
+		 * \param filename The text file with the order of activities or the .res file with the schedule.
+		 * \param numberOfActivities The number of activities of the instance.
+		 * \exception invalid_argument The file cannot be opened or the number of activities does not match.
+		 * \exception runtime_error The file is corrupted or it contains an invalid id of an activity.
+		 * \return The order of activities with the ids of the input file.
+		 */
+		static std::vector<uint32_t> readWarmStartOrder(const std::string& filename, const uint32_t& numberOfActivities);
+		/*!
+		 * \param project The data of the instance.
+		 * \param trajectory The trajectory whose current order is checked.
+		 * \return True if the current order was visited in the last SolverConfig::cycleDetectionHistory iterations else false.
+		 * \brief The hash of the current order is compared with the hashes of the recent orders and then it is remembered.
+		 */
+		static bool detectCycle(const InstanceData& project, SearchTrajectory& trajectory);
+
+		/*!
+		 * In the speculative mode the threads that finished their part of the neighbourhood start to evaluate the neighbourhood
+		 * of the order obtained by the best candidate move known at that time. The last thread meanwhile applies the best move.
+		 * The speculatively evaluated rows are reused in the next iteration if the candidate move was applied, else they are thrown away.
+		 * \param project The data of the instance.
+		 * \param trajectory The search trajectory in which one iteration is performed.
+		 * \param graphFile The csv file to which the criterion of the iteration is written. It can be NULL.
+		 * \exception runtime_error Unsupported type of move.
+		 * \brief The neighbourhood of the current order is evaluated, the best allowed move is applied and the tabu list is updated.
+		 */
+		static void performSearchIteration(const InstanceData& project, SearchTrajectory& trajectory, FILE *graphFile);
+		/*!
+		 * \param project The data of the instance.
+		 * \param solution The solution whose order is the centre of the neighbourhood. The best makespan determines the penalty.
+		 * \param threadOrder The thread copy of the order of the solution. It is restored after each move.
+		 * \param threadStartTimesById Auxiliary array of start times.
+		 * \param i The index of the row, i.e. the index of the first moved activity.
+		 * \param algo The selected evaluation algorithm.
+		 * \param swapRange Maximal distance between swapped activities.
+		 * \param shiftRange Maximal number of activities that could be skipped by the shifted activity.
+		 * \param scheme The schedule generation scheme that decodes the orders after the moves.
+		 * \param cache The cache of the evaluated orders or NULL if the cache is disabled.
+		 * \param orderHash The Zobrist hash of the order of the solution, it is not used if the cache is disabled.
+		 * \param cacheHits It is increased by the number of moves whose cost was found in the cache.
+		 * \param lowerBoundData The data of the lower bound filter for the order of the solution or NULL if the moves are not filtered.
+		 * \param tabu The tabu list that decides which moves can be selected, it is used only by the lower bound filter.
+		 * \param bestMoveCost The cost of the best move selected by the thread so far, it is used only by the lower bound filter.
+		 * \param prunedMoves It is increased by the number of moves skipped by the lower bound filter.
+		 * \param criticalActivities The flags of the critical activities, only the moves of the critical activities are evaluated. NULL means all moves.
+		 * \param moves All precedence feasible swap and shift moves of the row with their costs, except the moves skipped by the filter.
+		 * \return The number of evaluated schedules, i.e. the moves without a cached cost.
+		 * \brief It evaluates all moves of the neighbourhood that start at the index i. The tabu list is consulted only by the filter,
+		 * a move is skipped if its lower bound shows that it cannot be selected neither as the allowed move nor by the aspiration criterion.
+		 */
+		static uint32_t evaluateNeighbourhoodRow(const InstanceData& project, const InstanceSolution& solution, uint32_t *threadOrder, uint32_t *threadStartTimesById,
+				const uint32_t& i, EvaluationAlgorithm algo, const uint32_t& swapRange, const uint32_t& shiftRange, const ScheduleGenerationScheme& scheme,
+				EvaluationCache *cache, const uint64_t& orderHash, uint64_t& cacheHits,
+				const MoveLowerBoundData *lowerBoundData, const TabuList *tabu, const uint32_t& bestMoveCost, uint64_t& prunedMoves,
+				const uint8_t *criticalActivities, std::vector<EvaluatedMove>& moves);
+		/*!
+		 * \param project The data of the instance.
+		 * \param solution The current solution.
+		 * \param algo The selected evaluation algorithm.
+		 * \param scheme The schedule generation scheme that decodes the current order.
+		 * \param startTimesById The schedule of the current order is written to this array.
+		 * \param criticalActivities The flags of the critical activities are written to this array.
+		 * \return The number of critical activities.
+		 * \brief The activities that finish at the makespan are critical. The critical chains are traced backward, each critical activity
+		 * is linked to one activity that finishes at its start time. It is a predecessor if the activity starts at its precedence earliest time,
+		 * else it requires a resource that did not have enough free capacity just before the start. The binding resources of all activities
+		 * are found by one sweep over the start and finish times, the whole tracing takes O(n log n) time plus the number of requirements.
+		 */
+		static uint32_t computeCriticalActivities(const InstanceData& project, const InstanceSolution& solution, EvaluationAlgorithm algo,
+				const ScheduleGenerationScheme& scheme, uint32_t *startTimesById, uint8_t * const& criticalActivities);
+		/*!
+		 * \param project The data of the instance.
+		 * \param solution The current solution, its best makespan determines the penalty.
+		 * \param algo The selected evaluation algorithm.
+		 * \param lowerBoundData The schedule of the current order and the prefix bounds are written to this structure.
+		 * \brief The current order is evaluated and the bounds of its prefixes are computed, the prefixes of the neighbour orders are scheduled equally.
+		 */
+		static void computeMoveLowerBoundData(const InstanceData& project, const InstanceSolution& solution, EvaluationAlgorithm algo, MoveLowerBoundData& lowerBoundData);
+		/*!
+		 * \param project The data of the instance.
+		 * \param solution The current solution, its best makespan determines the penalty.
+		 * \param lowerBoundData The data of the lower bound filter for the current order.
+		 * \param moveOrder The order after the move.
+		 * \param firstPosition The first position changed by the move.
+		 * \param lastPosition The last position changed by the move.
+		 * \param lowerStartTimesById Auxiliary array, the lower bounds of the start times of the moved activities are written to it.
+		 * \return A lower bound of the makespan plus the overhang penalty of the order after the move.
+		 * \brief The activities before the first position keep their start times. The start times of the moved activities are bounded
+		 * from below by their predecessors and the makespan is bounded by the longest paths to the end, it takes O(range) time.
+		 */
+		static uint32_t computeMoveLowerBound(const InstanceData& project, const InstanceSolution& solution, const MoveLowerBoundData& lowerBoundData,
+				const uint32_t * const& moveOrder, const uint32_t& firstPosition, const uint32_t& lastPosition, uint32_t * const& lowerStartTimesById);
+		/*!
+		 * \param project The data of the instance.
+		 * \param solution The solution whose order is the centre of the neighbourhood. The best makespan determines the penalty.
+		 * \param moveSolution The solution with the order after the move.
+		 * \param threadStartTimesById Auxiliary array of start times.
+		 * \param algo The selected evaluation algorithm.
+		 * \param scheme The schedule generation scheme that decodes the order after the move.
+		 * \param cache The cache of the evaluated orders or NULL if the cache is disabled.
+		 * \param moveHash The Zobrist hash of the order after the move.
+		 * \param cacheHits It is increased by one if the cost was found in the cache.
+		 * \return Makespan plus the overhang penalty of the order after the move.
+		 * \brief The cost of the move is taken from the cache if possible, else the order is evaluated and the cost is stored to the cache.
+		 */
+		static uint32_t evaluateMoveCost(const InstanceData& project, const InstanceSolution& solution, const InstanceSolution& moveSolution, uint32_t *threadStartTimesById,
+				EvaluationAlgorithm algo, const ScheduleGenerationScheme& scheme, EvaluationCache *cache, const uint64_t& moveHash, uint64_t& cacheHits);
+		/*!
+		 * \param project The data of the instance.
+		 * \param trajectory The search trajectory.
+		 * \param iterBestMove The best move of the neighbourhood.
+		 * \param neighborhoodSize The number of accepted moves. If zero then the tabu list is pruned.
+		 * \param graphFile The csv file to which the criterion of the iteration is written. It can be NULL.
+		 * \exception runtime_error Unsupported type of move.
+		 * \brief It updates the tabu list, applies the best move, updates the best solution and performs the diversification if required.
+		 */
+		static void finishSearchIteration(const InstanceData& project, SearchTrajectory& trajectory, const EvaluatedMove& iterBestMove, const size_t& neighborhoodSize, FILE *graphFile);
+		/*!
+		 * \param order Activities order.
+		 * \param move The swap or shift move.
+		 * \param orderHash The Zobrist hash of the order, the keys of the changed positions are replaced.
+		 * \exception runtime_error Unsupported type of move.
+		 * \brief The move is applied to the order and the hash is updated in the time proportional to the length of the move.
+		 */
+		static void applyMove(uint32_t * const& order, const EvaluatedMove& move, uint64_t& orderHash);
+		/*!
+		 * \param project The data of the instance.
+		 * \param trajectory The trajectory whose current order is hashed.
+		 * \return The Zobrist hash of the current order of the trajectory.
+		 * \brief The hash kept by the trajectory is returned, it is computed from scratch only if the order was changed otherwise than by a move.
+		 */
+		static uint64_t currentOrderHash(const InstanceData& project, SearchTrajectory& trajectory);
+		/*!
+		 * \param maxIter Number of iterations that should be performed by each island.
+		 * \param deadline The wall clock time at which the search is stopped.
+		 * \brief Islands are searched concurrently and their best orders are exchanged after every SolverConfig::islandExchangeInterval iterations.
+		 */
+		void solveScheduleIslands(const uint32_t& maxIter, const double& deadline);
+		/*!
+		 * \param maxIter Number of iterations that should be performed by each walker.
+		 * \param deadline The wall clock time at which the search is stopped.
+		 * \brief Each island is an independent walker that runs until its iterations or the time are exhausted or
+		 * any walker reaches the critical path makespan. A walker that improves the best makespan publishes it
+		 * through an atomic variable and adds its order to the elite pool. After every SolverConfig::islandExchangeInterval iterations the walker
+		 * continues from a random better elite order if the shared best makespan is better than its own best makespan.
+		 */
+		void solveScheduleAsynchronously(const uint32_t& maxIter, const double& deadline);
+		/*!
+		 * \brief The best orders of all islands are put to the elite pool. Each island continues from a randomly
+		 * selected better elite order if such order exists.
+		 */
+		void exchangeEliteSolutions();
+		/*!
+		 * \param project The data of the instance.
+		 * \param config The configuration of the solver, it sets up the advanced tabu list.
+		 * \param type The type of the tabu list.
+		 * \param tabuListSize The size of the simple tabu list. The advanced tabu list is not affected.
+		 * \exception invalid_argument Invalid type of tabu list.
+		 * \return The tabu list of the given type.
+		 */
+		static TabuList* createTabuList(const InstanceData& project, const SolverConfig& config, const TabuType& type, const uint32_t& tabuListSize);
+		/*!
+		 * \param member The index of the portfolio member (island).
+		 * \param trajectory The trajectory whose type of tabu list, tabu list size and swap range are set. Its configuration has to be set.
+		 * \brief Members alternate the simple and the advanced tabu list, each pair of members uses a different
+		 * swap range and simple tabu list size derived from the configured values.
+		 */
+		static void setPortfolioMember(const uint32_t& member, SearchTrajectory& trajectory);
+		//! Return the trajectory with the shortest found schedule. The earlier found one is preferred if more such trajectories exist.
+		const SearchTrajectory& getBestTrajectory() const;
+		//! Return the current wall clock time at seconds.
+		static double getWallClockTime();
+		/*!
+		 * \param trajectory The trajectory whose team the calling thread belongs to.
+		 * \brief The calling thread is bound to the NUMA node of the trajectory if the NUMA placement is enabled.
+		 * The node that was really used is remembered for the report.
+		 */
+		static void bindTrajectoryThread(SearchTrajectory& trajectory);
+		/*!
+		 * \param trajectory The trajectory whose team the calling thread belongs to.
+		 * \brief The calling thread gets back its original affinity. It is called at the end of the parallel regions that bind
+		 * the threads, the pooled threads of OpenMP are not left bound for the other solvers.
+		 */
+		static void unbindTrajectoryThread(const SearchTrajectory& trajectory);
+		/*!
+		 * \param project The original instance data.
+		 * \param topology The NUMA topology of the machine.
+		 * \param node The index of the NUMA node.
+		 * \param replica The created replica is written to this pointer.
+		 * \brief The thread binds itself to the node and creates the replica, the memory is therefore placed on the node by the first touch.
+		 */
+		static void buildNumaReplica(const InstanceData *project, const NumaTopology *topology, uint32_t node, InstanceData **replica);
+		/*!
+		 * \param project The instance data to be copied.
+		 * \return The deep copy of the read-only arrays of the instance data. The caches of all successors/predecessors are shared.
+		 * \warning The replica has to be freed by the destroyInstanceDataReplica method.
+		 */
+		static InstanceData* createInstanceDataReplica(const InstanceData& project);
+		//! Free the replica created by the createInstanceDataReplica method.
+		static void destroyInstanceDataReplica(InstanceData *replica);
+		/*!
+		 * \param state The state of the generator. It has to be non-zero.
+		 * \return A pseudo-random number.
+		 * \brief Xorshift generator, each trajectory has its own state so that the walkers do not share the state of rand().
+		 */
+		static uint32_t generateRandomNumber(uint32_t& state);
 
 		/*!
 		 * \param project The data of the project instance.
@@ -253,7 +759,10 @@ class ScheduleSolver {
 
 		/* IMMUTABLE DATA */
 
-		//! A static parameters of a RCPSP project.
+		/*!
+		 * A static parameters of a RCPSP project. All arrays except the row pointers, the longest paths and the caches
+		 * are sections of one aligned arena. The row pointers point to the rows of the arena sections.
+		 */
 		struct InstanceData	{
 			//! Number of renewable sources.
 			uint32_t numberOfResources;
@@ -261,6 +770,10 @@ class ScheduleSolver {
 			uint32_t *capacityOfResources;
 			//! Total number of activities.
 			uint32_t numberOfActivities;
+			//! Total number of precedence edges.
+			uint32_t numberOfEdges;
+			//! Total number of non-zero resource requirements of all activities.
+			uint32_t numberOfRequirements;
 			//! Duration of activities.
 			uint32_t *durationOfActivities;
 			//! Activities successors;
@@ -275,12 +788,42 @@ class ScheduleSolver {
 			uint32_t **requiredResourcesOfActivities;
 			//! Matrix of successors. (if matrix(i,j) == 1 then "Exist precedence edge between activities i and j")
 			int8_t **matrixOfSuccessors;
+			//! The successors of the activity i are successorIds[successorsOffsets[i]] ... successorIds[successorsOffsets[i+1]-1].
+			uint32_t *successorsOffsets;
+			//! The successors of all activities (CSR format).
+			uint32_t *successorIds;
+			//! The predecessors of the activity i are predecessorIds[predecessorsOffsets[i]] ... predecessorIds[predecessorsOffsets[i+1]-1].
+			uint32_t *predecessorsOffsets;
+			//! The predecessors of all activities (CSR format).
+			uint32_t *predecessorIds;
+			//! Resource requirements, the row-major matrix (number of activities x number of resources).
+			uint32_t *requirementsMatrix;
+			//! The non-zero requirements of the activity i are resourceRequirements[requirementsOffsets[i]] ... resourceRequirements[requirementsOffsets[i+1]-1].
+			uint32_t *requirementsOffsets;
+			//! The non-zero resource requirements of all activities sorted by the resource id (CSR format).
+			ResourceRequirement *resourceRequirements;
+			//! The row-major matrix of successors.
+			int8_t *successorsMatrix;
+			//! The allocated memory of the arena, the sections start at the aligned address.
+			uint8_t *instanceArena;
+			//! The ids of the activities in the input file if the activities were renumbered, else empty.
+			std::vector<uint32_t> originalIdOfActivity;
+			//! The internal ids of the activities indexed by the ids in the input file if the activities were renumbered, else empty.
+			std::vector<uint32_t> internalIdOfActivity;
 			//! Critical Path Makespan. (Critical Path Method)
 			int32_t criticalPathMakespan;
 			//! The longest paths from the end activity in the transformed graph.
 			uint32_t *rightLeftLongestPaths;
 			//! Upper bound of Cmax (sum of all activity durations).
 			uint32_t upperBoundMakespan;
+			//! The size in bytes of the time values stored by the capacity resolution, it is derived from the upper bound of Cmax.
+			uint8_t timeValueBytes;
+			//! The size in bytes of the remaining capacities stored by the time resolution, it is derived from the maximal capacity.
+			uint8_t capacityValueBytes;
+			//! It creates the capacity resolution evaluator selected for the instance.
+			SourcesLoadFactory capacityResolutionFactory;
+			//! It creates the time resolution evaluator selected for the instance.
+			SourcesLoadFactory timeResolutionFactory;
 			//! All successors of an activity. Cache purposes.
 			std::vector<std::vector<uint32_t>*> allSuccessorsCache;
 			//! All predecessors of an activity. Cache purposes.
@@ -303,21 +846,138 @@ class ScheduleSolver {
 			uint32_t costOfBestSchedule;
 		};
 
-		//! The current solution of the read instance.
-		InstanceSolution instanceSolution;
-
-		//! Tabu list instance.
-		TabuList *tabu;
-		//! Current selected version of resources evaluation algorithm.
-		EvaluationAlgorithm algo;
-		//! Required evaluation time per iteration for evaluation algorithm TIME_RESOLUTION.
-		double reqTimePerIterForTimeResAlg;
-		//! Required evaluation time per iteration for evaluation algorithm CAPACITY_RESOLUTION.
-		double reqTimePerIterForCapacityResAlg;
-		//! Purpose of this variable is to remember total time.
+		//! A move of the neighbourhood together with its cost.
+		struct EvaluatedMove	{
+			//! The type of the move.
+			MoveType type;
+			//! The index of the moved activity.
+			uint32_t i;
+			//! The index of the swapped activity or the target index of the shift.
+			uint32_t j;
+			//! Makespan plus the overhang penalty of the order after the move.
+			uint32_t cost;
+		};
+
+		//! The data of the current order that are used to compute the lower bounds of the costs of the moves.
+		struct MoveLowerBoundData	{
+			//! The start times of the activities in the schedule of the current order.
+			uint32_t *startTimesById;
+			//! The position of each activity in the current order.
+			uint32_t *positionOfActivity;
+			//! The lower bound of the makespan given by the activities at the positions 0 ... k-1 is stored at the index k.
+			uint32_t *prefixMakespanBound;
+			//! The overhang penalty of the activities at the positions 0 ... k-1 is stored at the index k.
+			uint32_t *prefixPenalty;
+		};
+
+		//! The state of one tabu search trajectory (island).
+		struct SearchTrajectory	{
+			//! The current and the best solution of the trajectory.
+			InstanceSolution solution;
+			//! Tabu list of the trajectory.
+			TabuList *tabu;
+			//! Current selected version of resources evaluation algorithm.
+			EvaluationAlgorithm algo;
+			//! Required evaluation time per iteration for evaluation algorithm TIME_RESOLUTION.
+			double reqTimePerIterForTimeResAlg;
+			//! Required evaluation time per iteration for evaluation algorithm CAPACITY_RESOLUTION.
+			double reqTimePerIterForCapacityResAlg;
+			//! The number of performed iterations.
+			uint32_t iteration;
+			//! The number of iterations since the best solution of the trajectory was found.
+			uint32_t numberOfIterSinceBest;
+			//! The number of threads that evaluate the neighbourhood of the trajectory.
+			uint32_t numberOfThreads;
+			//! Total number of evaluated schedules of the trajectory.
+			uint64_t numberOfEvaluatedSchedules;
+			//! Total number of the moves whose cost was found in the evaluation cache.
+			uint64_t numberOfCacheHits;
+			//! The hashes of the recently visited orders, it is a circular buffer.
+			std::vector<uint64_t> recentOrderHashes;
+			//! The index of the oldest hash in recentOrderHashes.
+			uint32_t nextRecentOrderHash;
+			//! True if the tabu list was pruned due to a cycle since the last improvement or diversification.
+			bool prunedAfterCycle;
+			//! The number of detected cycles.
+			uint32_t numberOfDetectedCycles;
+			//! The number of diversifications that were called due to a cycle.
+			uint32_t numberOfCycleDiversifications;
+			//! The number of iterations without improvement that were skipped by the diversifications due to a cycle.
+			uint64_t numberOfSavedIterations;
+			//! The data of the lower bound filter, the arrays are allocated only if the filter is enabled.
+			MoveLowerBoundData lowerBoundData;
+			//! Total number of the moves that were skipped by the lower bound filter.
+			uint64_t numberOfPrunedMoves;
+			//! The flags of the critical activities of the current schedule, allocated only if the critical neighbourhood is enabled.
+			uint8_t *criticalActivities;
+			//! The schedule of the current order, allocated only if the critical neighbourhood is enabled.
+			uint32_t *criticalStartTimesById;
+			//! The number of iterations in which only the critical neighbourhood was evaluated.
+			uint32_t numberOfRestrictedIterations;
+			//! The sum of the numbers of critical activities over the restricted iterations.
+			uint64_t numberOfCriticalActivities;
+			//! The wall clock time when the best solution of the trajectory was found.
+			double timeOfBestSolution;
+			//! The type of the tabu list of the trajectory.
+			TabuType tabuType;
+			//! Maximal distance between swapped activities.
+			uint32_t swapRange;
+			//! The size of the simple tabu list.
+			uint32_t tabuListSize;
+			//! The configuration of the solver.
+			const SolverConfig *config;
+			//! The instance data used by the trajectory, it is a replica on the NUMA node of the trajectory if the NUMA placement is enabled.
+			const InstanceData *project;
+			//! The cache of the evaluated orders shared by all trajectories, NULL if the cache is disabled.
+			EvaluationCache *evaluationCache;
+			//! The NUMA topology if the threads of the trajectory are bound, else NULL.
+			const NumaTopology *numaTopology;
+			//! The index of the NUMA node of the trajectory.
+			uint32_t numaNode;
+			//! The system identification of the NUMA node on which the trajectory really ran, -1 if unknown.
+			int32_t usedNumaNode;
+			//! The state of the random generator of the trajectory.
+			uint32_t randomState;
+			//! Flags of the neighbourhood rows that are evaluated in the current iteration if the neighbourhood is sampled.
+			std::vector<uint8_t> sampledRows;
+			//! True if the rows in speculativeRows belong to the neighbourhood of the current order.
+			bool speculationValid;
+			//! The Zobrist hash of the current order, it is updated by applyMove.
+			uint64_t orderHash;
+			//! False if the current order was changed otherwise than by applyMove, the hash is computed again when it is required.
+			bool orderHashValid;
+			//! The order after the speculated move.
+			uint32_t *speculativeOrder;
+			//! Speculatively evaluated rows of the neighbourhood of the current order.
+			std::vector<std::vector<EvaluatedMove> > speculativeRows;
+			//! Flags of the evaluated rows in speculativeRows.
+			std::vector<uint8_t> speculativeRowReady;
+			//! Rows of the neighbourhood of the speculated order that are evaluated in the current iteration.
+			std::vector<std::vector<EvaluatedMove> > nextSpeculativeRows;
+			//! Flags of the evaluated rows in nextSpeculativeRows.
+			std::vector<uint8_t> nextSpeculativeRowReady;
+		};
+
+		//! The configuration of the solver.
+		const SolverConfig config;
+		//! Search trajectories, one for each island.
+		SearchTrajectory *trajectories;
+		//! The number of islands.
+		uint32_t numberOfIslands;
+		//! The pool of the best orders exchanged among islands. Allocated only in the island mode.
+		ElitePool *elitePool;
+		//! The NUMA topology if the NUMA placement is enabled, else NULL.
+		NumaTopology *numaTopology;
+		//! The cache of the evaluated orders, NULL if the cache is disabled.
+		EvaluationCache *evaluationCache;
+		//! The replicas of the instance data, one for each NUMA node.
+		std::vector<InstanceData*> numaReplicas;
+		//! The time of the initialisation, the warm start and the instance changes that is charged to the next solveSchedule call.
+		double setupTime;
+		//! The run time of the last solveSchedule call including the setup time, or the setup time before the first call.
 		double totalRunTime;
-		//! Total number of evaluaded schedules on the CPU.
-		uint64_t numberOfEvaluatedSchedules;
+		//! The time from the start of the last solveSchedule call (including the setup time) to the best solution.
+		double timeToBest;
 };
 
 #endif
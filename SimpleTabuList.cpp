@@ -55,7 +55,7 @@ void SimpleTabuList::addTurnToTabuList(const uint32_t& i, const uint32_t& j, con
 	curIdx = (curIdx+1) % tabuLength;
 }
 
-void SimpleTabuList::prune()	{
+void SimpleTabuList::prune(uint32_t& randomState)	{
 	vector<uint32_t> indicesOfValidMoves;
 	uint32_t numberOfValidMovesInTabuList = 0;
 	for (uint32_t m = 0; m < tabuLength; ++m)	{
@@ -64,7 +64,8 @@ void SimpleTabuList::prune()	{
 			++numberOfValidMovesInTabuList;
 		}
 	}
-	random_shuffle(indicesOfValidMoves.begin(), indicesOfValidMoves.end());
+	ShuffleGenerator generator(randomState);
+	random_shuffle(indicesOfValidMoves.begin(), indicesOfValidMoves.end(), generator);
 
 	uint32_t theNumberOfMovesToRemove = (uint32_t) 0.3*numberOfValidMovesInTabuList;
 	for (uint32_t m = 0; m < theNumberOfMovesToRemove; ++m)	{
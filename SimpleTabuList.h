@@ -72,8 +72,9 @@ class SimpleTabuList : public TabuList {
 		/*!
 		 * If the tabu list does not allow to select any solution in the neighbourhood
 		 * some random moves are required to be pruned from the tabu list. The method removes 30 % of the tabu list moves.
+		 * \param randomState The state of the random generator of the search trajectory.
 		 */
-		virtual void prune();
+		virtual void prune(uint32_t& randomState);
 
 		//! Free all allocated resources. (i.e. tabu list and tabu hash)
 		virtual ~SimpleTabuList();
@@ -23,9 +23,24 @@
  * \brief Abstract class for the evaluation algorithms.
  */
 
+#include <stdint.h>
+
+/*!
+ * \struct ResourceRequirement
+ * \brief The non-zero requirement of an activity for one resource.
+ */
+struct ResourceRequirement {
+	//! The id of the required resource.
+	uint32_t resourceId;
+	//! The required capacity of the resource, always positive.
+	uint32_t demand;
+};
+
 /*!
  * Activities are put to the schedule one after another (sequence is determined by activities order)
  * and state of the resources has to be updated correctly. This state is stored in derived classes from the SourcesLoad.
+ * The requirements of an activity are passed as a list of the required resources, i.e. the resources
+ * without the requirement of the activity are skipped.
  * \class SourcesLoad
  * \brief The SourcesLoad abstract class that defines required operations for resources evaluation.
  */
@@ -35,21 +50,24 @@ class SourcesLoad {
 		SourcesLoad() { };
 
 		/*!
-		 * \param activityResourceRequirements Activity requirement for each available resource.
+		 * \param activityRequirements The non-zero requirements of the activity.
+		 * \param numberOfRequirements The number of the non-zero requirements.
 		 * \param earliestPrecedenceStartTime The earliest start time of the activity without precedence violation.
 		 * \param activityDuration Duration of the activity.
 		 * \return The earliest activity start time without resource overload.
 		 * \brief It finds out the earliest possible activity start time without resource overload.
 		 */
-		virtual uint32_t getEarliestStartTime(const uint32_t * const& activityResourceRequirements,
+		virtual uint32_t getEarliestStartTime(const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements,
 			       const uint32_t& earliestPrecedenceStartTime, const uint32_t& activityDuration) const = 0;
 		/*!
 		 * \param activityStart Scheduled start time of the activity.
 		 * \param activityStop Finish time of the scheduled activity.
-		 * \param activityRequirements Activity requirement for each available resource.
+		 * \param activityRequirements The non-zero requirements of the activity.
+		 * \param numberOfRequirements The number of the non-zero requirements.
 		 * \brief It updates state of resources with respect to the added activity.
 		 */
-		virtual void addActivity(const uint32_t& activityStart, const uint32_t& activityStop, const uint32_t * const& activityRequirements) = 0;
+		virtual void addActivity(const uint32_t& activityStart, const uint32_t& activityStop,
+				const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements) = 0;
 
 		//! Virtual implicit destructor.
 		virtual ~SourcesLoad() { };
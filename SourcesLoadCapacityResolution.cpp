@@ -20,54 +20,61 @@
 
 using namespace std;
 
-SourcesLoadCapacityResolution::SourcesLoadCapacityResolution(const uint32_t& numberOfResources, const uint32_t * const& capacitiesOfResources)
+template <class T>
+SourcesLoadCapacityResolution<T>::SourcesLoadCapacityResolution(const uint32_t& numberOfResources, const uint32_t * const& capacitiesOfResources)
 	: numberOfResources(numberOfResources), capacitiesOfResources(capacitiesOfResources)	{
 	uint32_t maxCapacity = 0;
-	resourcesLoad = new uint32_t*[numberOfResources];
+	resourcesLoad = new T*[numberOfResources];
 
 	for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
-		resourcesLoad[resourceId] = new uint32_t[capacitiesOfResources[resourceId]];
-		memset(resourcesLoad[resourceId], 0, sizeof(uint32_t)*capacitiesOfResources[resourceId]);
+		resourcesLoad[resourceId] = new T[capacitiesOfResources[resourceId]];
+		memset(resourcesLoad[resourceId], 0, sizeof(T)*capacitiesOfResources[resourceId]);
 		maxCapacity = max(capacitiesOfResources[resourceId], maxCapacity);
 	}
 
-	startValues = new uint32_t[maxCapacity];
-	memset(startValues, 0, sizeof(uint32_t)*maxCapacity);
+	startValues = new T[maxCapacity];
+	memset(startValues, 0, sizeof(T)*maxCapacity);
 }
 
-uint32_t SourcesLoadCapacityResolution::getEarliestStartTime(const uint32_t * const& activityResourceRequirements, const uint32_t&, const uint32_t&) const {
+template <class T>
+uint32_t SourcesLoadCapacityResolution<T>::getEarliestStartTime(const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements,
+		const uint32_t&, const uint32_t&) const {
 	uint32_t bestStart = 0;
-	for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
-		uint32_t activityRequirement = activityResourceRequirements[resourceId];
-		if (activityRequirement > 0)
-			bestStart = max(resourcesLoad[resourceId][capacitiesOfResources[resourceId]-activityRequirement], bestStart);
-	}
+	for (const ResourceRequirement *req = activityRequirements; req < activityRequirements+numberOfRequirements; ++req)
+		bestStart = max((uint32_t) resourcesLoad[req->resourceId][capacitiesOfResources[req->resourceId]-req->demand], bestStart);
 	return bestStart;
 }
 
-void SourcesLoadCapacityResolution::addActivity(const uint32_t& activityStart, const uint32_t& activityStop, const uint32_t * const& activityRequirements)	{
+template <class T>
+void SourcesLoadCapacityResolution<T>::addActivity(const uint32_t& activityStart, const uint32_t& activityStop,
+		const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements)	{
 	#if DEBUG_SOURCES == 1
+	// The debug check works with the requirements for all resources.
+	vector<uint32_t> denseRequirements(numberOfResources, 0);
+	for (uint32_t idx = 0; idx < numberOfRequirements; ++idx)
+		denseRequirements[activityRequirements[idx].resourceId] = activityRequirements[idx].demand;
+
 	map<uint32_t,int32_t*>::iterator mit;
 	if ((mit = peaks.find(activityStart)) == peaks.end())	{
 		int32_t *peak = new int32_t[numberOfResources];
 		for (uint32_t idx = 0; idx < numberOfResources; ++idx)
-			peak[idx] = -((int32_t) activityRequirements[idx]);
+			peak[idx] = -((int32_t) denseRequirements[idx]);
 		peaks[activityStart] = peak;
 	} else {
 		int32_t *peak = mit->second;
 		for (uint32_t idx = 0; idx < numberOfResources; ++idx)
-			peak[idx] -= (int32_t) activityRequirements[idx];
+			peak[idx] -= (int32_t) denseRequirements[idx];
 	}
 
 	if ((mit = peaks.find(activityStop)) == peaks.end())	{
 		int32_t *peak = new int32_t[numberOfResources];
 		for (uint32_t idx = 0; idx < numberOfResources; ++idx)
-			peak[idx] = (int32_t) activityRequirements[idx];
+			peak[idx] = (int32_t) denseRequirements[idx];
 		peaks[activityStop] = peak;
 	} else {
 		int32_t *peak = mit->second;
 		for (uint32_t idx = 0; idx < numberOfResources; ++idx)
-			peak[idx] += (int32_t) activityRequirements[idx];
+			peak[idx] += (int32_t) denseRequirements[idx];
 	}
 
 	int32_t lastLevel, cumulativeValue;
@@ -95,19 +102,20 @@ void SourcesLoadCapacityResolution::addActivity(const uint32_t& activityStart, c
 		}
 	}
 
-	uint32_t **resourcesLoadCopy = new uint32_t*[numberOfResources];
+	T **resourcesLoadCopy = new T*[numberOfResources];
 	for (uint32_t i = 0; i < numberOfResources; ++i)	{
-		resourcesLoadCopy[i] = new uint32_t[capacitiesOfResources[i]];
+		resourcesLoadCopy[i] = new T[capacitiesOfResources[i]];
 		for (uint32_t j = 0; j < capacitiesOfResources[i]; ++j)
 			resourcesLoadCopy[i][j] = resourcesLoad[i][j];
 	}
 	#endif
 
 	int32_t requiredSquares, timeDiff;
-	uint32_t k, c, capacityOfResource, resourceRequirement, newStartTime;
-	for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
+	uint32_t k, c, resourceId, capacityOfResource, resourceRequirement, newStartTime;
+	for (const ResourceRequirement *req = activityRequirements; req < activityRequirements+numberOfRequirements; ++req)	{
+		resourceId = req->resourceId;
 		capacityOfResource = capacitiesOfResources[resourceId];
-		resourceRequirement = activityRequirements[resourceId];
+		resourceRequirement = req->demand;
 		requiredSquares = resourceRequirement*(activityStop-activityStart);
 		if (requiredSquares > 0)	{
 			c = 0; newStartTime = activityStop;
@@ -116,7 +124,7 @@ void SourcesLoadCapacityResolution::addActivity(const uint32_t& activityStart, c
 				if (resourcesLoad[resourceId][k] < newStartTime)    {
 					if (c >= resourceRequirement)
 						newStartTime = startValues[c-resourceRequirement];
-					timeDiff = newStartTime-max(resourcesLoad[resourceId][k],activityStart);
+					timeDiff = newStartTime-max((uint32_t) resourcesLoad[resourceId][k], activityStart);
 					if (requiredSquares-timeDiff > 0)	{
 						requiredSquares -= timeDiff;
 						startValues[c++] = resourcesLoad[resourceId][k];
@@ -182,10 +190,10 @@ void SourcesLoadCapacityResolution::addActivity(const uint32_t& activityStart, c
 		if (!correct)	{
 			cerr<<"Resource id: "<<resourceId<<endl;
 			cerr<<"activity times: "<<activityStart<<" "<<activityStop<<endl;
-			cerr<<"activity requirement: "<<activityRequirements[resourceId]<<endl;
+			cerr<<"activity requirement: "<<denseRequirements[resourceId]<<endl;
 			cerr<<"Original start times vector: "<<endl;
 			for (uint32_t i = 0; i < capacityOfResource; ++i)	{
-				cerr<<" "<<resourcesLoadCopy[resourceId][i];
+				cerr<<" "<<(uint32_t) resourcesLoadCopy[resourceId][i];
 			}
 			cerr<<endl;
 			cerr<<"Probably correct result: "<<endl;
@@ -195,7 +203,7 @@ void SourcesLoadCapacityResolution::addActivity(const uint32_t& activityStart, c
 			cerr<<endl;
 			cerr<<"Probably incorrect result: "<<endl;
 			for (uint32_t i = 0; i < capacityOfResource; ++i)	{
-				cerr<<" "<<resourcesLoad[resourceId][i];
+				cerr<<" "<<(uint32_t) resourcesLoad[resourceId][i];
 			}
 			cerr<<endl;
 			cerr<<"Time of peaks and values:"<<endl;
@@ -218,21 +226,24 @@ void SourcesLoadCapacityResolution::addActivity(const uint32_t& activityStart, c
 	#endif
 }
 
-void SourcesLoadCapacityResolution::printCurrentState(ostream& output)	const	{
+template <class T>
+void SourcesLoadCapacityResolution<T>::printCurrentState(ostream& output)	const	{
 	for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
 		output<<"Resource "<<resourceId+1<<":";
 		for (uint32_t capIdx = 0; capIdx < capacitiesOfResources[resourceId]; ++capIdx)	
-			output<<" "<<resourcesLoad[resourceId][capIdx];
+			output<<" "<<(uint32_t) resourcesLoad[resourceId][capIdx];
 		output<<endl;
 	}
 }
 
-bool SourcesLoadCapacityResolution::cmpMethod(const uint32_t& i, const uint32_t& j)	{
+template <class T>
+bool SourcesLoadCapacityResolution<T>::cmpMethod(const uint32_t& i, const T& j)	{
 	return i > j ? true : false;
 }
 
-SourcesLoadCapacityResolution::~SourcesLoadCapacityResolution()	{
-	for (uint32_t** ptr = resourcesLoad; ptr < resourcesLoad+numberOfResources; ++ptr)
+template <class T>
+SourcesLoadCapacityResolution<T>::~SourcesLoadCapacityResolution()	{
+	for (T** ptr = resourcesLoad; ptr < resourcesLoad+numberOfResources; ++ptr)
 		delete[] *ptr;
 	delete[] resourcesLoad;
 	delete[] startValues;
@@ -242,3 +253,7 @@ SourcesLoadCapacityResolution::~SourcesLoadCapacityResolution()	{
 	#endif
 }
 
+template class SourcesLoadCapacityResolution<uint8_t>;
+template class SourcesLoadCapacityResolution<uint16_t>;
+template class SourcesLoadCapacityResolution<uint32_t>;
+
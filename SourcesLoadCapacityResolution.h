@@ -42,9 +42,13 @@
 #endif
 
 /*!
+ * The stored values are the start times, the narrowest type that can hold the upper bound of the makespan should be used.
+ * The class is instantiated for uint8_t, uint16_t and uint32_t in SourcesLoadCapacityResolution.cpp.
+ * \tparam T The unsigned integer type of the stored times.
  * \class SourcesLoadCapacityResolution
  * \brief All sources states are stored and updated in this class.
  */
+template <class T>
 class SourcesLoadCapacityResolution : public SourcesLoad {
 	public:
 		/*!
@@ -55,20 +59,24 @@ class SourcesLoadCapacityResolution : public SourcesLoad {
 		SourcesLoadCapacityResolution(const uint32_t& numberOfResources, const uint32_t * const& capacitiesOfResources);
 
 		/*!
-		 * \param activityResourceRequirements Activity requirements.
+		 * \param activityRequirements The non-zero activity requirements.
+		 * \param numberOfRequirements The number of the non-zero requirements.
 		 * \return The earliest start time of activity (precedence relations aren't counted).
 		 * \brief Compute earliest start time of the activity with given sources requirements.
 		 * \note The last two parameters are unused in the method.
 		 */
-		virtual uint32_t getEarliestStartTime(const uint32_t * const& activityResourceRequirements, const uint32_t&, const uint32_t&) const;
+		virtual uint32_t getEarliestStartTime(const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements,
+				const uint32_t&, const uint32_t&) const;
 		/*!
 		 * \param activityStart Start time of activity.
 		 * \param activityStop Stop time of the activity. (= activityStart + activityDuration)
-		 * \param activityRequirements Activity resources requirements.
+		 * \param activityRequirements The non-zero activity requirements.
+		 * \param numberOfRequirements The number of the non-zero requirements.
 		 * \brief Update sources vectors (arrays). This operation is irreversible.
 		 * \note Method can be debugged.
 		 */
-		virtual void addActivity(const uint32_t& activityStart, const uint32_t& activityStop, const uint32_t * const& activityRequirements);
+		virtual void addActivity(const uint32_t& activityStart, const uint32_t& activityStop,
+				const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements);
 		/*!
 		 * \param output Output stream.
 		 * \brief Print current state of resources.
@@ -80,7 +88,7 @@ class SourcesLoadCapacityResolution : public SourcesLoad {
 		 * \return i > j ? true : false;
 		 * \brief Comparator function is used in upper_bound function that is used in the addActivity method.
 		 */
-		static bool cmpMethod(const uint32_t& i, const uint32_t& j);
+		static bool cmpMethod(const uint32_t& i, const T& j);
 
 		//! Free all allocated memory.
 		virtual ~SourcesLoadCapacityResolution();
@@ -98,9 +106,9 @@ class SourcesLoadCapacityResolution : public SourcesLoad {
 		//! Capacities of resources.
 		const uint32_t * const capacitiesOfResources;
 		//! Current state of resources.
-		uint32_t **resourcesLoad;
+		T **resourcesLoad;
 		//! Helper array that is used at addActivity method.
-		uint32_t *startValues;
+		T *startValues;
 
 		#if DEBUG_SOURCES == 1
 		//! Save current state of the resources as a peaks. Only in debug mode.
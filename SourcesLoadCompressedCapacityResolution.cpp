@@ -0,0 +1,185 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include "SourcesLoadCompressedCapacityResolution.h"
+
+using namespace std;
+
+template <class T>
+SourcesLoadCompressedCapacityResolution<T>::SourcesLoadCompressedCapacityResolution(const uint32_t& numberOfResources, const uint32_t * const& capacitiesOfResources)
+	: numberOfResources(numberOfResources), capacitiesOfResources(capacitiesOfResources)	{
+	uint32_t maxCapacity = 0;
+	levelTimes = new T*[numberOfResources];
+	levelCounts = new uint32_t*[numberOfResources];
+	numberOfLevels = new uint32_t[numberOfResources];
+
+	// The number of distinct levels cannot exceed the capacity. All units are free at the beginning.
+	for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
+		levelTimes[resourceId] = new T[capacitiesOfResources[resourceId]];
+		levelCounts[resourceId] = new uint32_t[capacitiesOfResources[resourceId]];
+		levelTimes[resourceId][0] = 0;
+		levelCounts[resourceId][0] = capacitiesOfResources[resourceId];
+		numberOfLevels[resourceId] = 1;
+		maxCapacity = max(capacitiesOfResources[resourceId], maxCapacity);
+	}
+
+	newLevelTimes = new T[maxCapacity];
+	newLevelCounts = new uint32_t[maxCapacity];
+	startLevelTimes = new T[maxCapacity];
+	startLevelCounts = new uint32_t[maxCapacity];
+}
+
+template <class T>
+uint32_t SourcesLoadCompressedCapacityResolution<T>::getEarliestStartTime(const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements,
+		const uint32_t&, const uint32_t&) const {
+	uint32_t bestStart = 0;
+	for (const ResourceRequirement *req = activityRequirements; req < activityRequirements+numberOfRequirements; ++req)	{
+		// The release time of the unit with the index capacity-demand in the decreasing order.
+		uint32_t unitIdx = capacitiesOfResources[req->resourceId]-req->demand, l = 0;
+		const uint32_t * const counts = levelCounts[req->resourceId];
+		while (unitIdx >= counts[l])
+			unitIdx -= counts[l++];
+		bestStart = max((uint32_t) levelTimes[req->resourceId][l], bestStart);
+	}
+	return bestStart;
+}
+
+template <class T>
+void SourcesLoadCompressedCapacityResolution<T>::addActivity(const uint32_t& activityStart, const uint32_t& activityStop,
+		const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements)	{
+	for (const ResourceRequirement *req = activityRequirements; req < activityRequirements+numberOfRequirements; ++req)	{
+		const uint32_t resourceId = req->resourceId, resourceRequirement = req->demand;
+		int32_t requiredSquares = resourceRequirement*(activityStop-activityStart);
+		if (requiredSquares <= 0)
+			continue;
+
+		T *times = levelTimes[resourceId];
+		uint32_t *counts = levelCounts[resourceId];
+		uint32_t &levels = numberOfLevels[resourceId];
+
+		// The levels with the release time at or after the activity stop are not changed.
+		uint32_t firstLevel = 0;
+		while (firstLevel < levels && times[firstLevel] >= activityStop)
+			++firstLevel;
+
+		/*
+		 * The units are processed level by level in the same way as in the SourcesLoadCapacityResolution::addActivity method.
+		 * The new start time and the consumed squares are the same for a block of units of one level
+		 * while the start value of the unit c-resourceRequirement belongs to one level of the original release times.
+		 */
+		uint32_t numberOfNewLevels = 0, numberOfStartLevels = 0, startLevel = 0, startLevelOffset = 0;
+		uint32_t c = 0, newStartTime = activityStop, l = firstLevel, remainingUnits = (l < levels ? counts[l] : 0);
+		while (requiredSquares > 0 && l < levels)	{
+			uint32_t levelTime = times[l];
+			if (levelTime < newStartTime)	{
+				uint32_t blockSize = remainingUnits;
+				if (c >= resourceRequirement)	{
+					newStartTime = startLevelTimes[startLevel];
+					blockSize = min(blockSize, startLevelCounts[startLevel]-startLevelOffset);
+				} else {
+					blockSize = min(blockSize, resourceRequirement-c);
+				}
+
+				// The following units of the block are not changed if the level time is equal to the new start time.
+				if (levelTime >= newStartTime)
+					blockSize = 1;
+
+				int32_t timeDiff = newStartTime-max(levelTime, activityStart);
+				if (timeDiff > 0)
+					blockSize = min(blockSize, (uint32_t) ((requiredSquares-1)/timeDiff));
+
+				if (blockSize > 0)	{
+					requiredSquares -= blockSize*timeDiff;
+					appendLevel(startLevelTimes, startLevelCounts, numberOfStartLevels, levelTime, blockSize);
+					appendLevel(newLevelTimes, newLevelCounts, numberOfNewLevels, newStartTime, blockSize);
+					if (c >= resourceRequirement)	{
+						startLevelOffset += blockSize;
+						if (startLevelOffset == startLevelCounts[startLevel])	{
+							++startLevel;
+							startLevelOffset = 0;
+						}
+					}
+					c += blockSize;
+					remainingUnits -= blockSize;
+				} else {
+					appendLevel(newLevelTimes, newLevelCounts, numberOfNewLevels, newStartTime-timeDiff+requiredSquares, 1);
+					--remainingUnits;
+					break;
+				}
+			} else {
+				appendLevel(newLevelTimes, newLevelCounts, numberOfNewLevels, levelTime, remainingUnits);
+				remainingUnits = 0;
+			}
+
+			if (remainingUnits == 0 && ++l < levels)
+				remainingUnits = counts[l];
+		}
+
+		// The rest of the levels is copied, the updated levels replace the original ones.
+		if (l < levels)	{
+			appendLevel(newLevelTimes, newLevelCounts, numberOfNewLevels, times[l], remainingUnits);
+			for (++l; l < levels; ++l)
+				appendLevel(newLevelTimes, newLevelCounts, numberOfNewLevels, times[l], counts[l]);
+		}
+
+		levels = firstLevel;
+		for (uint32_t newLevel = 0; newLevel < numberOfNewLevels; ++newLevel)
+			appendLevel(times, counts, levels, newLevelTimes[newLevel], newLevelCounts[newLevel]);
+	}
+}
+
+template <class T>
+void SourcesLoadCompressedCapacityResolution<T>::printCurrentState(ostream& output)	const	{
+	for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
+		output<<"Resource "<<resourceId+1<<":";
+		for (uint32_t l = 0; l < numberOfLevels[resourceId]; ++l)
+			output<<" "<<(uint32_t) levelTimes[resourceId][l]<<"x"<<levelCounts[resourceId][l];
+		output<<endl;
+	}
+}
+
+template <class T>
+void SourcesLoadCompressedCapacityResolution<T>::appendLevel(T *times, uint32_t *counts, uint32_t& numberOfLevels, const uint32_t& time, const uint32_t& count)	{
+	if (count == 0)
+		return;
+	if (numberOfLevels > 0 && times[numberOfLevels-1] == time)	{
+		counts[numberOfLevels-1] += count;
+	} else {
+		times[numberOfLevels] = time;
+		counts[numberOfLevels++] = count;
+	}
+}
+
+template <class T>
+SourcesLoadCompressedCapacityResolution<T>::~SourcesLoadCompressedCapacityResolution()	{
+	for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
+		delete[] levelTimes[resourceId];
+		delete[] levelCounts[resourceId];
+	}
+	delete[] levelTimes;
+	delete[] levelCounts;
+	delete[] numberOfLevels;
+	delete[] newLevelTimes;
+	delete[] newLevelCounts;
+	delete[] startLevelTimes;
+	delete[] startLevelCounts;
+}
+
+template class SourcesLoadCompressedCapacityResolution<uint8_t>;
+template class SourcesLoadCompressedCapacityResolution<uint16_t>;
+template class SourcesLoadCompressedCapacityResolution<uint32_t>;
+
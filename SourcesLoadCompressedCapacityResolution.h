@@ -0,0 +1,117 @@
+/*
+	This file is part of the RCPSPCpu program.
+
+	RCPSPCpu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	RCPSPCpu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
+*/
+#ifndef HLIDAC_PES_SOURCES_LOAD_COMPRESSED_CAPACITY_RESOLUTION_H
+#define HLIDAC_PES_SOURCES_LOAD_COMPRESSED_CAPACITY_RESOLUTION_H
+
+/*!
+ * \file SourcesLoadCompressedCapacityResolution.h
+ * \author Libor Bukata
+ * \brief Implementation of SourcesLoadCompressedCapacityResolution class.
+ */
+
+#include <iostream>
+#include <stdint.h>
+#include "SourcesLoad.h"
+
+//! The compressed capacity resolution is used if a resource has a capacity higher than this threshold.
+#define COMPRESSED_CAPACITY_THRESHOLD 64
+
+/*!
+ * The algorithm is the same as in the SourcesLoadCapacityResolution class, but the release times of the capacity units
+ * are stored as distinct (time, count) levels. The cost of the methods depends on the number of distinct levels
+ * instead of the capacities of the resources, it is suitable for resources with a large capacity.
+ * The class is instantiated for uint8_t, uint16_t and uint32_t in SourcesLoadCompressedCapacityResolution.cpp.
+ * \tparam T The unsigned integer type of the stored times.
+ * \class SourcesLoadCompressedCapacityResolution
+ * \brief The run-length encoded state of the resources for the capacity resolution.
+ */
+template <class T>
+class SourcesLoadCompressedCapacityResolution : public SourcesLoad {
+	public:
+		/*!
+		 * \param numberOfResources Number of resources.
+		 * \param capacitiesOfResources Capacities of resources.
+		 * \brief Allocate the levels of the resources and helper arrays.
+		 */
+		SourcesLoadCompressedCapacityResolution(const uint32_t& numberOfResources, const uint32_t * const& capacitiesOfResources);
+
+		/*!
+		 * \param activityRequirements The non-zero activity requirements.
+		 * \param numberOfRequirements The number of the non-zero requirements.
+		 * \return The earliest start time of activity (precedence relations aren't counted).
+		 * \brief Compute earliest start time of the activity with given sources requirements.
+		 * \note The last two parameters are unused in the method.
+		 */
+		virtual uint32_t getEarliestStartTime(const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements,
+				const uint32_t&, const uint32_t&) const;
+		/*!
+		 * \param activityStart Start time of activity.
+		 * \param activityStop Stop time of the activity. (= activityStart + activityDuration)
+		 * \param activityRequirements The non-zero activity requirements.
+		 * \param numberOfRequirements The number of the non-zero requirements.
+		 * \brief Update the levels of the required resources. This operation is irreversible.
+		 */
+		virtual void addActivity(const uint32_t& activityStart, const uint32_t& activityStop,
+				const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements);
+		/*!
+		 * \param output Output stream.
+		 * \brief Print current levels of resources.
+		 */
+		void printCurrentState(std::ostream& output = std::cout) const;
+
+		//! Free all allocated memory.
+		virtual ~SourcesLoadCompressedCapacityResolution();
+
+	private:
+
+		//! Copy constructor is forbidden.
+		SourcesLoadCompressedCapacityResolution(const SourcesLoadCompressedCapacityResolution&);
+		//! Asignment operator is forbidden.
+		SourcesLoadCompressedCapacityResolution& operator=(const SourcesLoadCompressedCapacityResolution&);
+
+		/*!
+		 * \param times The times of the levels.
+		 * \param counts The numbers of units of the levels.
+		 * \param numberOfLevels The number of levels, it is increased if a new level is appended.
+		 * \param time The release time of the appended units.
+		 * \param count The number of appended units.
+		 * \brief The units are appended to the last level if it has the same time else a new level is created.
+		 */
+		static void appendLevel(T *times, uint32_t *counts, uint32_t& numberOfLevels, const uint32_t& time, const uint32_t& count);
+
+		//! Total number of resources.
+		const uint32_t numberOfResources;
+		//! Capacities of resources.
+		const uint32_t * const capacitiesOfResources;
+		//! The distinct release times of the units of each resource in the decreasing order.
+		T **levelTimes;
+		//! The number of units of the resource r released at levelTimes[r][l] is levelCounts[r][l].
+		uint32_t **levelCounts;
+		//! The number of levels of each resource.
+		uint32_t *numberOfLevels;
+		//! Helper array for the times of the updated levels that is used at addActivity method.
+		T *newLevelTimes;
+		//! Helper array for the counts of the updated levels that is used at addActivity method.
+		uint32_t *newLevelCounts;
+		//! Helper array for the original release times of the updated units that is used at addActivity method.
+		T *startLevelTimes;
+		//! Helper array for the counts of the original release times that is used at addActivity method.
+		uint32_t *startLevelCounts;
+};
+
+#endif
+
@@ -14,48 +14,146 @@
 	You should have received a copy of the GNU General Public License
 	along with RCPSPCpu. If not, see <http://www.gnu.org/licenses/>.
 */
+#include <algorithm>
 #include "SourcesLoadTimeResolution.h"
 
 using namespace std;
 
-SourcesLoadTimeResolution::SourcesLoadTimeResolution(const uint32_t& numberOfResources, const uint32_t * const& capacitiesOfResources, const uint32_t& makespanUpperBound)
-       	: numberOfResources(numberOfResources), capacitiesOfResources(capacitiesOfResources), makespanUpperBound(makespanUpperBound)	{
-	remainingResourcesCapacity = new uint32_t*[numberOfResources];
-	for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
-		remainingResourcesCapacity[resourceId] = new uint32_t[makespanUpperBound];
-		for (uint32_t t = 0; t < makespanUpperBound; ++t)
-			remainingResourcesCapacity[resourceId][t] = capacitiesOfResources[resourceId];
+template <class T, uint32_t R>
+SourcesLoadTimeResolution<T, R>::SourcesLoadTimeResolution(const uint32_t& numberOfResources, const uint32_t * const& capacitiesOfResources,
+		const uint32_t& timeHorizon, const uint32_t& makespanUpperBound) : numberOfResources(numberOfResources), capacitiesOfResources(capacitiesOfResources),
+	makespanUpperBound(makespanUpperBound), horizon(min(timeHorizon, makespanUpperBound)), remainingResourcesCapacity(NULL), remainingCapacityByTime(NULL)	{
+	if (R > 0)	{
+		remainingCapacityByTime = new T[horizon*R];
+	} else {
+		remainingResourcesCapacity = new T*[numberOfResources];
+		for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)
+			remainingResourcesCapacity[resourceId] = new T[horizon];
 	}
+	initialiseCapacities(0);
 }
 
-uint32_t SourcesLoadTimeResolution::getEarliestStartTime(const uint32_t * const& activityResourceRequirements,
+template <class T, uint32_t R>
+uint32_t SourcesLoadTimeResolution<T, R>::getEarliestStartTime(const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements,
 		const uint32_t& earliestPrecedenceStartTime, const uint32_t& activityDuration)	const 	{
-	uint32_t loadTime = 0, t = makespanUpperBound;
-	for (t = earliestPrecedenceStartTime; t < makespanUpperBound && loadTime < activityDuration; ++t)	{
-		bool capacityAvailable = true;
-		for (uint32_t resourceId = 0; resourceId < numberOfResources && capacityAvailable; ++resourceId)	{
-			if (remainingResourcesCapacity[resourceId][t] < activityResourceRequirements[resourceId])	{
-				loadTime = 0;
-				capacityAvailable = false;
+	uint32_t loadTime = 0, t = earliestPrecedenceStartTime;
+	if (R > 0)	{
+		// The zero requirements are always satisfied, the check of all resources has no branches.
+		T demands[R > 0 ? R : 1] = { };
+		for (const ResourceRequirement *req = activityRequirements; req < activityRequirements+numberOfRequirements; ++req)
+			demands[req->resourceId] = req->demand;
+		for (; t < horizon && loadTime < activityDuration; ++t)	{
+			const T * const remaining = remainingCapacityByTime+t*R;
+			bool capacityAvailable = true;
+			for (uint32_t resourceId = 0; resourceId < R; ++resourceId)
+				capacityAvailable &= (remaining[resourceId] >= demands[resourceId]);
+			loadTime = (capacityAvailable ? loadTime+1 : 0);
+		}
+	} else {
+		const ResourceRequirement * const lastRequirement = activityRequirements+numberOfRequirements;
+		for (; t < horizon && loadTime < activityDuration; ++t)	{
+			bool capacityAvailable = true;
+			for (const ResourceRequirement *req = activityRequirements; req < lastRequirement && capacityAvailable; ++req)	{
+				if (remainingResourcesCapacity[req->resourceId][t] < req->demand)	{
+					loadTime = 0;
+					capacityAvailable = false;
+				}
 			}
+			if (capacityAvailable)
+				++loadTime;
 		}
-		if (capacityAvailable)
-			++loadTime;
 	}
+
+	// The resources are free after the horizon.
+	if (loadTime < activityDuration && t < makespanUpperBound)	{
+		uint32_t stopTime = min(t+activityDuration-loadTime, makespanUpperBound);
+		loadTime += stopTime-t;
+		t = stopTime;
+	}
+
 	return t-loadTime;
 }
 
-void SourcesLoadTimeResolution::addActivity(const uint32_t& activityStart, const uint32_t& activityStop, const uint32_t * const& activityRequirements)	{
-	for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
-		for (uint32_t t = activityStart; t < activityStop; ++t)	{
-			remainingResourcesCapacity[resourceId][t] -= activityRequirements[resourceId];
+template <class T, uint32_t R>
+void SourcesLoadTimeResolution<T, R>::addActivity(const uint32_t& activityStart, const uint32_t& activityStop,
+		const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements)	{
+	if (activityStop > horizon)
+		growHorizon(activityStop);
+
+	if (R > 0)	{
+		T demands[R > 0 ? R : 1] = { };
+		for (const ResourceRequirement *req = activityRequirements; req < activityRequirements+numberOfRequirements; ++req)
+			demands[req->resourceId] = req->demand;
+		for (T *remaining = remainingCapacityByTime+activityStart*R; remaining < remainingCapacityByTime+activityStop*R; remaining += R)	{
+			for (uint32_t resourceId = 0; resourceId < R; ++resourceId)
+				remaining[resourceId] -= demands[resourceId];
+		}
+	} else {
+		for (const ResourceRequirement *req = activityRequirements; req < activityRequirements+numberOfRequirements; ++req)	{
+			T *remainingCapacity = remainingResourcesCapacity[req->resourceId];
+			for (uint32_t t = activityStart; t < activityStop; ++t)	{
+				remainingCapacity[t] -= req->demand;
+			}
+		}
+	}
+}
+
+template <class T, uint32_t R>
+void SourcesLoadTimeResolution<T, R>::growHorizon(const uint32_t& time)	{
+	uint32_t oldHorizon = horizon;
+	horizon = min(max(time, 2*horizon), max(time, makespanUpperBound));
+	if (R > 0)	{
+		T *capacities = new T[horizon*R];
+		copy(remainingCapacityByTime, remainingCapacityByTime+oldHorizon*R, capacities);
+		delete[] remainingCapacityByTime;
+		remainingCapacityByTime = capacities;
+	} else {
+		for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)	{
+			T *capacities = new T[horizon];
+			copy(remainingResourcesCapacity[resourceId], remainingResourcesCapacity[resourceId]+oldHorizon, capacities);
+			delete[] remainingResourcesCapacity[resourceId];
+			remainingResourcesCapacity[resourceId] = capacities;
 		}
 	}
+	initialiseCapacities(oldHorizon);
 }
 
-SourcesLoadTimeResolution::~SourcesLoadTimeResolution()	{
-	for (uint32_t** ptr = remainingResourcesCapacity; ptr < remainingResourcesCapacity+numberOfResources; ++ptr)
-		delete[] *ptr;
-	delete[] remainingResourcesCapacity;
+template <class T, uint32_t R>
+void SourcesLoadTimeResolution<T, R>::initialiseCapacities(const uint32_t& firstTime)	{
+	if (R > 0)	{
+		for (T *remaining = remainingCapacityByTime+firstTime*R; remaining < remainingCapacityByTime+horizon*R; remaining += R)	{
+			for (uint32_t resourceId = 0; resourceId < R; ++resourceId)
+				remaining[resourceId] = capacitiesOfResources[resourceId];
+		}
+	} else {
+		for (uint32_t resourceId = 0; resourceId < numberOfResources; ++resourceId)
+			fill(remainingResourcesCapacity[resourceId]+firstTime, remainingResourcesCapacity[resourceId]+horizon, capacitiesOfResources[resourceId]);
+	}
 }
 
+template <class T, uint32_t R>
+SourcesLoadTimeResolution<T, R>::~SourcesLoadTimeResolution()	{
+	if (remainingResourcesCapacity != NULL)	{
+		for (T** ptr = remainingResourcesCapacity; ptr < remainingResourcesCapacity+numberOfResources; ++ptr)
+			delete[] *ptr;
+		delete[] remainingResourcesCapacity;
+	}
+	delete[] remainingCapacityByTime;
+}
+
+//! It instantiates the generic variant and the variants specialized for 1 ... MAX_SPECIALIZED_RESOURCES resources.
+#define INSTANTIATE_SOURCES_LOAD_TIME_RESOLUTION(T) \
+	template class SourcesLoadTimeResolution<T, 0>; \
+	template class SourcesLoadTimeResolution<T, 1>; \
+	template class SourcesLoadTimeResolution<T, 2>; \
+	template class SourcesLoadTimeResolution<T, 3>; \
+	template class SourcesLoadTimeResolution<T, 4>; \
+	template class SourcesLoadTimeResolution<T, 5>; \
+	template class SourcesLoadTimeResolution<T, 6>; \
+	template class SourcesLoadTimeResolution<T, 7>; \
+	template class SourcesLoadTimeResolution<T, 8>;
+
+INSTANTIATE_SOURCES_LOAD_TIME_RESOLUTION(uint8_t)
+INSTANTIATE_SOURCES_LOAD_TIME_RESOLUTION(uint16_t)
+INSTANTIATE_SOURCES_LOAD_TIME_RESOLUTION(uint32_t)
+
@@ -27,35 +27,52 @@
 #include <stdint.h>
 #include "SourcesLoad.h"
 
+//! The maximal number of resources with the compile-time specialized evaluation kernel.
+#define MAX_SPECIALIZED_RESOURCES 8
+
 /*!
+ * The stored values are the remaining capacities, the narrowest type that can hold the maximal capacity should be used.
+ * If the number of resources R is known at compile time then the capacities are stored in the time-major order
+ * and all R resources are checked at once by the unrolled loops, the requirements are expanded to a dense row.
+ * The class is instantiated for uint8_t, uint16_t, uint32_t and R = 0..MAX_SPECIALIZED_RESOURCES in SourcesLoadTimeResolution.cpp.
+ * The capacities are stored only up to the time horizon, the resources are free after the horizon.
+ * The horizon is initially set to the expected length of the schedule and it grows if an activity finishes after the horizon.
+ * \tparam T The unsigned integer type of the stored capacities.
+ * \tparam R The number of resources or 0 if the number of resources is given at runtime (generic variant).
  * \class SourcesLoadTimeResolution
  * \brief Implementation of resources evaluation. For each time unit available free capacity is remembered.
  */
+template <class T, uint32_t R>
 class SourcesLoadTimeResolution : public SourcesLoad {
 	public:
 		/*!
 		 * \param numberOfResources Number of renewable resources with constant capacity.
 		 * \param capacitiesOfResources Maximal capacity of each resource.
+		 * \param timeHorizon The expected length of the schedule, the initial horizon of the stored capacities.
 		 * \param makespanUpperBound Estimate of maximal project duration.
 		 * \brief It allocates required data-structures and fill them with initial values.
 		 */
-		SourcesLoadTimeResolution(const uint32_t& numberOfResources, const uint32_t * const& capacitiesOfResources, const uint32_t& makespanUpperBound);
+		SourcesLoadTimeResolution(const uint32_t& numberOfResources, const uint32_t * const& capacitiesOfResources,
+				const uint32_t& timeHorizon, const uint32_t& makespanUpperBound);
 
 		/*!
-		 * \param activityResourceRequirements Activity requirement for each resource.
+		 * \param activityRequirements The non-zero requirements of the activity.
+		 * \param numberOfRequirements The number of the non-zero requirements.
 		 * \param earliestPrecedenceStartTime The earliest activity start time without precedence violation.
 		 * \param activityDuration Duration of the activity.
 		 * \return The earliest activity start time without precedence and resources violation.
 		 */
-		virtual uint32_t getEarliestStartTime(const uint32_t * const& activityResourceRequirements,
+		virtual uint32_t getEarliestStartTime(const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements,
 			       	const uint32_t& earliestPrecedenceStartTime, const uint32_t& activityDuration) const;
 		/*!
 		 * \param activityStart Start time of the scheduled activity.
 		 * \param activityStop Finish time of the scheduled activity.
-		 * \param activityRequirements Activity requirement for each resource.
+		 * \param activityRequirements The non-zero requirements of the activity.
+		 * \param numberOfRequirements The number of the non-zero requirements.
 		 * \brief Update state of resources with respect to the added activity.
 		 */
-		virtual void addActivity(const uint32_t& activityStart, const uint32_t& activityStop, const uint32_t * const& activityRequirements);
+		virtual void addActivity(const uint32_t& activityStart, const uint32_t& activityStop,
+				const ResourceRequirement * const& activityRequirements, const uint32_t& numberOfRequirements);
 
 		//! Free allocated memory.
 		virtual ~SourcesLoadTimeResolution();
@@ -67,14 +84,26 @@ class SourcesLoadTimeResolution : public SourcesLoad {
 		//! Assignment operator is forbidden.
 		SourcesLoadTimeResolution& operator=(const SourcesLoadTimeResolution&);
 
+		/*!
+		 * \param time The time that has to be covered by the stored capacities.
+		 * \brief The horizon is at least doubled (up to the upper bound of the project duration), the new time units are free.
+		 */
+		void growHorizon(const uint32_t& time);
+		//! The capacities of the resources are written to the time units from firstTime to the horizon.
+		void initialiseCapacities(const uint32_t& firstTime);
+
 		//! Number of renewable resources with constant capacity.
 		const uint32_t numberOfResources;
 		//! Capacities of the resources.
 		const uint32_t * const capacitiesOfResources;
 		//! Upper bound of the project duration.
 		const uint32_t makespanUpperBound;
-		//! Available capacity for each resource (independent variable is time).
-		uint32_t **remainingResourcesCapacity;
+		//! The capacities are stored for the time units lower than the horizon.
+		uint32_t horizon;
+		//! Available capacity for each resource (independent variable is time). Only the generic variant (R == 0).
+		T **remainingResourcesCapacity;
+		//! Available capacities of the resources at time t are remainingCapacityByTime[t*R] ... remainingCapacityByTime[t*R+R-1]. Only if R > 0.
+		T *remainingCapacityByTime;
 };
 
 #endif
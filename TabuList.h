@@ -23,6 +23,7 @@
  * \brief Abstract class definition of tabu list.
  */
 
+#include <cstddef>
 #include <stdint.h>
 #include "ConstantsRCPSP.h"
 
@@ -56,13 +57,41 @@ class TabuList	{
 		virtual void bestSolutionFound() { }; 
 		/*!
 		 * Tell tabu list about end of iteration.
+		 * \param randomState The state of the random generator of the search trajectory, it is used if the list is randomised.
 		 * \return Number of erased tabu list items.
 		 */
-		virtual uint32_t goToNextIter() { return 0; }; 
-		//! The method removes some tabu moves randomly since all solutions in neighbourhood were tabu.
-		virtual void prune() = 0;
+		virtual uint32_t goToNextIter(uint32_t&) { return 0; }; 
+		/*!
+		 * \param randomState The state of the random generator of the search trajectory.
+		 * \brief The method removes some tabu moves randomly since all solutions in neighbourhood were tabu.
+		 */
+		virtual void prune(uint32_t& randomState) = 0;
 		//! Virtual destructor of TabuList class.
 		virtual ~TabuList() { };
+
+	protected:
+
+		/*!
+		 * The generator draws the numbers from the xorshift state of the search trajectory (see ScheduleSolver::generateRandomNumber),
+		 * the tabu lists of the concurrent trajectories do not share the state of rand().
+		 * \class ShuffleGenerator
+		 * \brief The random generator for std::random_shuffle.
+		 */
+		class ShuffleGenerator	{
+			public:
+				//! The generator uses and advances the given state.
+				ShuffleGenerator(uint32_t& randomState) : state(randomState) { }
+				//! It returns a pseudo-random number from the range 0 to n-1.
+				ptrdiff_t operator()(ptrdiff_t n)	{
+					state ^= state << 13;
+					state ^= state >> 17;
+					state ^= state << 5;
+					return state % n;
+				}
+			private:
+				//! The state of the generator of the trajectory.
+				uint32_t& state;
+		};
 };
 
 #endif